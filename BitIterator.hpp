@@ -0,0 +1,208 @@
+#ifndef BITITERATOR_HPP
+# define BITITERATOR_HPP
+
+# include <stdint.h>
+# include <iterator>
+# include "IteratorTraits.hpp"
+
+namespace ft {
+
+// Bits of a packed vector<bool> are kept 64 to a word, bit i of the
+// sequence at bit i % 64 of word i / 64.
+typedef uint64_t        bit_word;
+static const unsigned   bit_word_bits = 64;
+
+// Stands in for bool& in a packed vector<bool>.
+class bit_reference
+{
+    bit_word*   _word;
+    bit_word    _mask;
+public:
+    bit_reference(bit_word* word, unsigned offset) : _word(word), _mask(bit_word(1) << offset)
+    {}
+
+    operator bool() const
+    { return (*_word & _mask); }
+
+    bool            operator~() const
+    { return (!(*_word & _mask)); }
+
+    bit_reference&  operator=(bool x)
+    {
+        if (x)
+            *_word |= _mask;
+        else
+            *_word &= ~_mask;
+        return (*this);
+    }
+
+    bit_reference&  operator=(const bit_reference& x)
+    { return (*this = bool(x)); }
+
+    void            flip()
+    { *_word ^= _mask; }
+};
+
+inline void swap(bit_reference x, bit_reference y)
+{
+    bool    tmp = x;
+    x = y;
+    y = tmp;
+}
+
+inline void swap(bit_reference x, bool& y)
+{
+    bool    tmp = x;
+    x = y;
+    y = tmp;
+}
+
+inline void swap(bool& x, bit_reference y)
+{
+    bool    tmp = x;
+    x = y;
+    y = tmp;
+}
+
+// Random-access iterator over packed bits: a word and a bit offset in it.
+// Moving by n steps whole words at once.
+template <bool IsConst>
+class BitIterator
+{
+public:
+    typedef ptrdiff_t                                               difference_type;
+    typedef bool                                                    value_type;
+    typedef typename conditional<IsConst, bool, bit_reference>::type    reference;
+    typedef void                                                    pointer;
+    typedef std::random_access_iterator_tag                         iterator_category;
+    typedef typename conditional<IsConst, const bit_word, bit_word>::type   word_type;
+private:
+    word_type*  _word;
+    unsigned    _offset;
+
+    void    advance(difference_type n)
+    {
+        difference_type pos = difference_type(_offset) + n;
+        difference_type words = pos / difference_type(bit_word_bits);
+        pos %= difference_type(bit_word_bits);
+        if (pos < 0)
+        {
+            pos += bit_word_bits;
+            --words;
+        }
+        _word += words;
+        _offset = unsigned(pos);
+    }
+public:
+    BitIterator(word_type* word = nullptr, unsigned offset = 0) : _word(word), _offset(offset)
+    {}
+
+    BitIterator(const BitIterator<false>& it) : _word(it.word()), _offset(it.offset())
+    {}
+
+    ~BitIterator()
+    {}
+
+    word_type*  word(void) const
+    { return (_word); }
+
+    unsigned    offset(void) const
+    { return (_offset); }
+
+    reference   operator * (void) const
+    { return (reference(bit_reference(const_cast<bit_word*>(_word), _offset))); }
+
+    reference   operator [] (difference_type i) const
+    { return (*(*this + i)); }
+
+    BitIterator&    operator ++ (void)
+    {
+        if (++_offset == bit_word_bits)
+        {
+            _offset = 0;
+            ++_word;
+        }
+        return (*this);
+    }
+
+    BitIterator&    operator -- (void)
+    {
+        if (_offset-- == 0)
+        {
+            _offset = bit_word_bits - 1;
+            --_word;
+        }
+        return (*this);
+    }
+
+    BitIterator     operator ++ (int)
+    {
+        BitIterator tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    BitIterator     operator -- (int)
+    {
+        BitIterator tmp(*this);
+        --(*this);
+        return (tmp);
+    }
+
+    BitIterator&    operator += (difference_type n)
+    {
+        advance(n);
+        return (*this);
+    }
+
+    BitIterator&    operator -= (difference_type n)
+    {
+        advance(-n);
+        return (*this);
+    }
+
+    BitIterator     operator + (difference_type n) const
+    {
+        BitIterator tmp(*this);
+        tmp.advance(n);
+        return (tmp);
+    }
+
+    BitIterator     operator - (difference_type n) const
+    {
+        BitIterator tmp(*this);
+        tmp.advance(-n);
+        return (tmp);
+    }
+
+    friend BitIterator  operator + (difference_type n, const BitIterator& it)
+    { return (it + n); }
+
+    friend difference_type  operator - (const BitIterator& lhs, const BitIterator& rhs)
+    {
+        return ((lhs._word - rhs._word) * difference_type(bit_word_bits)
+                + difference_type(lhs._offset) - difference_type(rhs._offset));
+    }
+
+    friend bool operator == (const BitIterator& lhs, const BitIterator& rhs)
+    { return (lhs._word == rhs._word && lhs._offset == rhs._offset); }
+
+    friend bool operator != (const BitIterator& lhs, const BitIterator& rhs)
+    { return (!(lhs == rhs)); }
+
+    friend bool operator < (const BitIterator& lhs, const BitIterator& rhs)
+    { return (lhs._word < rhs._word || (lhs._word == rhs._word && lhs._offset < rhs._offset)); }
+
+    friend bool operator > (const BitIterator& lhs, const BitIterator& rhs)
+    { return (rhs < lhs); }
+
+    friend bool operator <= (const BitIterator& lhs, const BitIterator& rhs)
+    { return (!(rhs < lhs)); }
+
+    friend bool operator >= (const BitIterator& lhs, const BitIterator& rhs)
+    { return (!(lhs < rhs)); }
+};
+
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef DEQUEITERATOR_HPP
+# define DEQUEITERATOR_HPP
+
+# include <iterator>
+# include "IteratorTraits.hpp"
+
+namespace ft {
+
+// Elements per block: about 4KB worth, rounded down to a power of two so
+// that index arithmetic compiles to shifts and masks.
+template <typename T>
+struct deque_block
+{
+    enum { bytes = 4096 };
+    enum { raw = sizeof(T) < bytes / 16 ? bytes / sizeof(T) : 16 };
+    enum { size = raw >= 256 ? (raw >= 1024 ? 1024 : (raw >= 512 ? 512 : 256))
+                : raw >= 64 ? (raw >= 128 ? 128 : 64)
+                : raw >= 32 ? 32 : 16 };
+};
+
+template <typename T, bool IsConst>
+class DequeIterator : public std::iterator<std::random_access_iterator_tag, T>
+{
+public:
+    typedef size_t                                                  size_type;
+    typedef ptrdiff_t                                               difference_type;
+    typedef T                                                       value_type;
+    typedef typename conditional<IsConst, const T*, T*>::type       pointer;
+    typedef typename conditional<IsConst, const T&, T&>::type       reference;
+    typedef std::random_access_iterator_tag                         iterator_category;
+    typedef T**                                                     map_pointer;
+
+    enum { block_size = deque_block<T>::size };
+
+    T*              _cur;
+    T*              _first;
+    map_pointer     _node;
+public:
+    DequeIterator() : _cur(nullptr), _first(nullptr), _node(nullptr)
+    {}
+
+    DequeIterator(map_pointer node, difference_type offset) : _cur(nullptr), _first(*node), _node(node)
+    {
+        if (_first)
+            _cur = _first + offset;
+    }
+
+    DequeIterator(const DequeIterator<T, false>& it) : _cur(it._cur), _first(it._first), _node(it._node)
+    {}
+
+    ~DequeIterator()
+    {}
+
+    reference   operator * (void) const
+    { return (*_cur); }
+
+    pointer     operator -> (void) const
+    { return (_cur); }
+
+    reference   operator [] (difference_type i) const
+    { return (*(*this + i)); }
+
+    DequeIterator&  operator ++ (void)
+    {
+        if (++_cur == _first + block_size)
+            set_node(_node + 1, 0);
+        return (*this);
+    }
+
+    DequeIterator&  operator -- (void)
+    {
+        if (_cur == _first)
+            set_node(_node - 1, block_size);
+        --_cur;
+        return (*this);
+    }
+
+    DequeIterator   operator ++ (int)
+    {
+        DequeIterator tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    DequeIterator   operator -- (int)
+    {
+        DequeIterator tmp(*this);
+        --(*this);
+        return (tmp);
+    }
+
+    DequeIterator&  operator += (difference_type n)
+    {
+        difference_type offset = (_cur - _first) + n;
+        if (offset >= 0 && offset < block_size)
+            _cur += n;
+        else
+        {
+            difference_type node_offset = offset >= 0 ? offset / block_size
+                                                      : -((-offset - 1) / block_size) - 1;
+            set_node(_node + node_offset, offset - node_offset * block_size);
+        }
+        return (*this);
+    }
+
+    DequeIterator&  operator -= (difference_type n)
+    { return (*this += -n); }
+
+    DequeIterator   operator + (difference_type n) const
+    {
+        DequeIterator tmp(*this);
+        return (tmp += n);
+    }
+
+    DequeIterator   operator - (difference_type n) const
+    {
+        DequeIterator tmp(*this);
+        return (tmp -= n);
+    }
+
+    friend DequeIterator    operator + (difference_type n, const DequeIterator& it)
+    { return (it + n); }
+
+    template <bool C>
+    difference_type operator - (const DequeIterator<T, C>& other) const
+    {
+        return ((_node - other._node) * difference_type(block_size)
+                + (_cur - _first) - (other._cur - other._first));
+    }
+
+    template <bool C>
+    bool    operator == (const DequeIterator<T, C>& other) const
+    { return (_cur == other._cur && _node == other._node); }
+
+    template <bool C>
+    bool    operator != (const DequeIterator<T, C>& other) const
+    { return !(*this == other); }
+
+    template <bool C>
+    bool    operator < (const DequeIterator<T, C>& other) const
+    { return (_node == other._node ? _cur < other._cur : _node < other._node); }
+
+    template <bool C>
+    bool    operator > (const DequeIterator<T, C>& other) const
+    { return (other < *this); }
+
+    template <bool C>
+    bool    operator <= (const DequeIterator<T, C>& other) const
+    { return !(other < *this); }
+
+    template <bool C>
+    bool    operator >= (const DequeIterator<T, C>& other) const
+    { return !(*this < other); }
+private:
+    void    set_node(map_pointer node, difference_type offset)
+    {
+        _node = node;
+        _first = *node;
+        _cur = _first ? _first + offset : nullptr;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef HASHITERATOR_HPP
+# define HASHITERATOR_HPP
+
+# include <iterator>
+# include "IteratorTraits.hpp"
+
+namespace ft {
+
+// Control byte of an open-addressed slot: a full slot stores the low seven
+// bits of its hash (0..127), everything else is negative. The byte after the
+// last slot is always hash_ctrl_end, which stops iteration.
+enum hash_ctrl
+{
+    hash_ctrl_empty     = -128,
+    hash_ctrl_deleted   = -2,
+    hash_ctrl_end       = -1
+};
+
+template <typename T, bool IsConst>
+class HashIterator : public std::iterator<std::forward_iterator_tag, T>
+{
+public:
+    typedef size_t                                                  size_type;
+    typedef ptrdiff_t                                               difference_type;
+    typedef T                                                       value_type;
+    typedef typename conditional<IsConst, const T*, T*>::type       pointer;
+    typedef typename conditional<IsConst, const T&, T&>::type       reference;
+    typedef std::forward_iterator_tag                               iterator_category;
+
+    const signed char*  _ctrl;
+    T*                  _slot;
+public:
+    HashIterator(const signed char* ctrl = nullptr, T* slot = nullptr) : _ctrl(ctrl), _slot(slot)
+    {}
+
+    HashIterator(const HashIterator<T, false>& it) : _ctrl(it._ctrl), _slot(it._slot)
+    {}
+
+    ~HashIterator()
+    {}
+
+    // Moves forward to the first full slot at or after the current one.
+    HashIterator&   skip(void)
+    {
+        while (*_ctrl < hash_ctrl_end)
+        {
+            ++_ctrl;
+            ++_slot;
+        }
+        return (*this);
+    }
+
+    reference   operator * (void) const
+    { return (*_slot); }
+
+    pointer     operator -> (void) const
+    { return (_slot); }
+
+    HashIterator&   operator ++ (void)
+    {
+        ++_ctrl;
+        ++_slot;
+        return (skip());
+    }
+
+    HashIterator    operator ++ (int)
+    {
+        HashIterator tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    template <bool C>
+    bool    operator == (const HashIterator<T, C>& other) const
+    { return (_slot == other._slot); }
+
+    template <bool C>
+    bool    operator != (const HashIterator<T, C>& other) const
+    { return !(*this == other); }
+};
+
+}
+
+#endif
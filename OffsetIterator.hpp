@@ -0,0 +1,117 @@
+#ifndef OFFSETITERATOR_HPP
+# define OFFSETITERATOR_HPP
+
+# include <iterator>
+# include "IteratorTraits.hpp"
+# include "node.hpp"
+
+namespace ft {
+
+// Iterator over an offset_map. It holds the address of the map's own
+// base pointer rather than a copy, so it stays valid when the arena grows
+// and moves; end() is offset 0.
+template <typename T, bool IsConst>
+class OffsetIterator : public std::iterator<std::bidirectional_iterator_tag, T>
+{
+public:
+    typedef size_t                                                  size_type;
+    typedef ptrdiff_t                                               difference_type;
+    typedef T                                                       value_type;
+    typedef typename conditional<IsConst, const T*, T*>::type       pointer;
+    typedef typename conditional<IsConst, const T&, T&>::type       reference;
+    typedef std::bidirectional_iterator_tag                         iterator_category;
+    typedef offset_node<T>                                          node_type;
+
+    char* const*    _base;
+    uint64_t        _off;
+private:
+    node_type*  at(uint64_t off) const
+    { return (reinterpret_cast<node_type*>(*_base + off)); }
+public:
+    OffsetIterator(char* const* base = nullptr, uint64_t off = 0) : _base(base), _off(off)
+    {}
+
+    OffsetIterator(const OffsetIterator<T, false>& it) : _base(it._base), _off(it._off)
+    {}
+
+    ~OffsetIterator()
+    {}
+
+    reference   operator * (void) const
+    { return (at(_off)->data); }
+
+    pointer     operator -> (void) const
+    { return (&at(_off)->data); }
+
+    OffsetIterator& operator ++ (void)
+    {
+        uint64_t    n = _off;
+        if (at(n)->right)
+        {
+            for (n = at(n)->right; at(n)->left; )
+                n = at(n)->left;
+            _off = n;
+            return (*this);
+        }
+        uint64_t    p = at(n)->parent;
+        while (p && at(p)->right == n)
+        {
+            n = p;
+            p = at(p)->parent;
+        }
+        _off = p;
+        return (*this);
+    }
+
+    // From end() this walks down to the last node from the root.
+    OffsetIterator& operator -- (void)
+    {
+        uint64_t    n = _off;
+        if (!n)
+        {
+            for (n = reinterpret_cast<const offset_arena_header*>(*_base)->root; at(n)->right; )
+                n = at(n)->right;
+            _off = n;
+            return (*this);
+        }
+        if (at(n)->left)
+        {
+            for (n = at(n)->left; at(n)->right; )
+                n = at(n)->right;
+            _off = n;
+            return (*this);
+        }
+        uint64_t    p = at(n)->parent;
+        while (p && at(p)->left == n)
+        {
+            n = p;
+            p = at(p)->parent;
+        }
+        _off = p;
+        return (*this);
+    }
+
+    OffsetIterator  operator ++ (int)
+    {
+        OffsetIterator  tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    OffsetIterator  operator -- (int)
+    {
+        OffsetIterator  tmp(*this);
+        --(*this);
+        return (tmp);
+    }
+
+    friend bool operator == (const OffsetIterator& lhs, const OffsetIterator& rhs)
+    { return (lhs._off == rhs._off); }
+
+    friend bool operator != (const OffsetIterator& lhs, const OffsetIterator& rhs)
+    { return (lhs._off != rhs._off); }
+};
+
+}
+
+#endif
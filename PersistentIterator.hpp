@@ -0,0 +1,150 @@
+#ifndef PERSISTENTITERATOR_HPP
+# define PERSISTENTITERATOR_HPP
+
+# include <iterator>
+# include "IteratorTraits.hpp"
+# include "node.hpp"
+
+namespace ft {
+
+// Nodes of a persistent tree are shared between versions and have no
+// parent link, so the iterator keeps the path from the root instead.
+// A red-black tree of n nodes is at most 2 * log2(n + 1) high.
+template <typename T>
+class PersistentIterator : public std::iterator<std::bidirectional_iterator_tag, T>
+{
+public:
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+    typedef T                                       value_type;
+    typedef const T*                                pointer;
+    typedef const T&                                reference;
+    typedef std::bidirectional_iterator_tag         iterator_category;
+    typedef persistent_node<T>                      node_type;
+
+    enum { max_depth = 128 };
+private:
+    const node_type*    _root;
+    const node_type*    _path[max_depth];
+    int                 _depth;
+
+    void    push_leftmost(const node_type* n)
+    {
+        for ( ; n; n = n->left)
+            _path[_depth++] = n;
+    }
+
+    void    push_rightmost(const node_type* n)
+    {
+        for ( ; n; n = n->right)
+            _path[_depth++] = n;
+    }
+public:
+    PersistentIterator(const node_type* root = nullptr) : _root(root), _depth(0)
+    {}
+
+    PersistentIterator(const PersistentIterator& other) : _root(other._root), _depth(other._depth)
+    {
+        for (int i = 0; i < _depth; ++i)
+            _path[i] = other._path[i];
+    }
+
+    PersistentIterator& operator = (const PersistentIterator& other)
+    {
+        _root = other._root;
+        _depth = other._depth;
+        for (int i = 0; i < _depth; ++i)
+            _path[i] = other._path[i];
+        return (*this);
+    }
+
+    ~PersistentIterator()
+    {}
+
+    static PersistentIterator   first(const node_type* root)
+    {
+        PersistentIterator  it(root);
+        it.push_leftmost(root);
+        return (it);
+    }
+
+    void    push(const node_type* n)
+    { _path[_depth++] = n; }
+
+    void    truncate(int depth)
+    { _depth = depth; }
+
+    int     depth(void) const
+    { return (_depth); }
+
+    const node_type*    base(void) const
+    { return (_depth ? _path[_depth - 1] : nullptr); }
+
+    PersistentIterator& operator ++ (void)
+    {
+        const node_type*    n = _path[_depth - 1];
+        if (n->right)
+        {
+            push_leftmost(n->right);
+            return (*this);
+        }
+        const node_type*    child;
+        do
+        {
+            child = _path[--_depth];
+        } while (_depth && _path[_depth - 1]->right == child);
+        return (*this);
+    }
+
+    PersistentIterator& operator -- (void)
+    {
+        if (!_depth)
+        {
+            push_rightmost(_root);
+            return (*this);
+        }
+        const node_type*    n = _path[_depth - 1];
+        if (n->left)
+        {
+            _path[_depth++] = n->left;
+            push_rightmost(n->left->right);
+            return (*this);
+        }
+        const node_type*    child;
+        do
+        {
+            child = _path[--_depth];
+        } while (_depth && _path[_depth - 1]->left == child);
+        return (*this);
+    }
+
+    PersistentIterator operator ++ (int)
+    {
+        PersistentIterator tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    PersistentIterator operator -- (int)
+    {
+        PersistentIterator tmp(*this);
+        --(*this);
+        return (tmp);
+    }
+
+    reference   operator * (void) const
+    { return (_path[_depth - 1]->data); }
+
+    pointer     operator -> (void) const
+    { return (&_path[_depth - 1]->data); }
+
+    friend bool operator == (const PersistentIterator& lhs, const PersistentIterator& rhs)
+    { return (lhs.base() == rhs.base()); }
+
+    friend bool operator != (const PersistentIterator& lhs, const PersistentIterator& rhs)
+    { return !(lhs == rhs); }
+};
+
+}
+
+#endif
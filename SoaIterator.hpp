@@ -0,0 +1,268 @@
+#ifndef SOAITERATOR_HPP
+# define SOAITERATOR_HPP
+
+# include <iterator>
+# include "IteratorTraits.hpp"
+# include "pair.hpp"
+
+namespace ft {
+
+// What dereferencing a soa_vector iterator gives: references to the two
+// fields of one record, which live in separate arrays. It reads like a
+// pair (r.first, r.second), converts to one, and assigning to it writes
+// through to both columns.
+template <typename A, typename B>
+struct soa_reference
+{
+    A&  first;
+    B&  second;
+
+    soa_reference(A& a, B& b) : first(a), second(b)
+    {}
+
+    soa_reference(const soa_reference& other) : first(other.first), second(other.second)
+    {}
+
+    template <typename U, typename V>
+    operator pair<U, V>() const
+    { return (pair<U, V>(first, second)); }
+
+    soa_reference&  operator=(const soa_reference& other)
+    {
+        first = other.first;
+        second = other.second;
+        return (*this);
+    }
+
+    template <typename U, typename V>
+    soa_reference&  operator=(const pair<U, V>& p)
+    {
+        first = p.first;
+        second = p.second;
+        return (*this);
+    }
+};
+
+// Swaps the records, not the references, so that std::sort and friends
+// can permute a soa_vector.
+template <typename A, typename B>
+void    swap(soa_reference<A, B> x, soa_reference<A, B> y)
+{
+    A   a(x.first);
+    B   b(x.second);
+    x.first = y.first;
+    x.second = y.second;
+    y.first = a;
+    y.second = b;
+}
+
+template <typename A, typename B, typename U, typename V>
+bool    operator==(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (x.first == y.first && x.second == y.second); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator!=(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (!(x == y)); }
+
+// Records order like ft::pair: by first, then by second. std::sort
+// compares proxies with each other and with the pair it holds aside, so
+// both mixes are covered.
+template <typename A, typename B, typename U, typename V>
+bool    soa_less(const A& xa, const B& xb, const U& ya, const V& yb)
+{ return (xa < ya || (xa == ya && xb < yb)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (soa_less(x.first, x.second, y.first, y.second)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (y < x); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<=(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (!(y < x)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>=(const soa_reference<A, B>& x, const soa_reference<U, V>& y)
+{ return (!(x < y)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator==(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (x.first == y.first && x.second == y.second); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator==(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (y == x); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator!=(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (!(x == y)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator!=(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (!(y == x)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (soa_less(x.first, x.second, y.first, y.second)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (soa_less(x.first, x.second, y.first, y.second)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (y < x); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (y < x); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<=(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (!(y < x)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator<=(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (!(y < x)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>=(const soa_reference<A, B>& x, const pair<U, V>& y)
+{ return (!(x < y)); }
+
+template <typename A, typename B, typename U, typename V>
+bool    operator>=(const pair<U, V>& x, const soa_reference<A, B>& y)
+{ return (!(x < y)); }
+
+// operator-> has to return something that itself has operator->; this
+// holds the proxy so that it->first works.
+template <typename Reference>
+struct soa_arrow
+{
+    Reference   ref;
+
+    explicit soa_arrow(const Reference& r) : ref(r)
+    {}
+
+    Reference*  operator->()
+    { return (&ref); }
+};
+
+// Random-access iterator over the records of a soa_vector: one pointer
+// per column, moved in step.
+template <typename A, typename B, bool IsConst>
+class SoaIterator
+{
+public:
+    typedef typename conditional<IsConst, const A, A>::type         first_type;
+    typedef typename conditional<IsConst, const B, B>::type         second_type;
+    typedef ptrdiff_t                                               difference_type;
+    typedef pair<A, B>                                              value_type;
+    typedef soa_reference<first_type, second_type>                  reference;
+    typedef soa_arrow<reference>                                    pointer;
+    typedef std::random_access_iterator_tag                         iterator_category;
+private:
+    first_type*     _first;
+    second_type*    _second;
+public:
+    SoaIterator(first_type* first = nullptr, second_type* second = nullptr) : _first(first), _second(second)
+    {}
+
+    SoaIterator(const SoaIterator<A, B, false>& it) : _first(it.first_base()), _second(it.second_base())
+    {}
+
+    ~SoaIterator()
+    {}
+
+    first_type*     first_base(void) const
+    { return (_first); }
+
+    second_type*    second_base(void) const
+    { return (_second); }
+
+    reference   operator * (void) const
+    { return (reference(*_first, *_second)); }
+
+    pointer     operator -> (void) const
+    { return (pointer(**this)); }
+
+    reference   operator [] (difference_type i) const
+    { return (reference(_first[i], _second[i])); }
+
+    SoaIterator&    operator ++ (void)
+    {
+        ++_first;
+        ++_second;
+        return (*this);
+    }
+
+    SoaIterator&    operator -- (void)
+    {
+        --_first;
+        --_second;
+        return (*this);
+    }
+
+    SoaIterator     operator ++ (int)
+    {
+        SoaIterator tmp(*this);
+        ++(*this);
+        return (tmp);
+    }
+
+    SoaIterator     operator -- (int)
+    {
+        SoaIterator tmp(*this);
+        --(*this);
+        return (tmp);
+    }
+
+    SoaIterator&    operator += (difference_type i)
+    {
+        _first += i;
+        _second += i;
+        return (*this);
+    }
+
+    SoaIterator&    operator -= (difference_type i)
+    {
+        _first -= i;
+        _second -= i;
+        return (*this);
+    }
+
+    SoaIterator     operator + (difference_type i) const
+    { return (SoaIterator(_first + i, _second + i)); }
+
+    SoaIterator     operator - (difference_type i) const
+    { return (SoaIterator(_first - i, _second - i)); }
+
+    friend SoaIterator  operator + (difference_type i, const SoaIterator& it)
+    { return (it + i); }
+
+    friend difference_type  operator - (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (lhs._first - rhs._first); }
+
+    friend bool operator == (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (lhs._first == rhs._first); }
+
+    friend bool operator != (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (lhs._first != rhs._first); }
+
+    friend bool operator < (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (lhs._first < rhs._first); }
+
+    friend bool operator > (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (rhs < lhs); }
+
+    friend bool operator <= (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (!(rhs < lhs)); }
+
+    friend bool operator >= (const SoaIterator& lhs, const SoaIterator& rhs)
+    { return (!(lhs < rhs)); }
+};
+
+}
+
+#endif
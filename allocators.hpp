@@ -0,0 +1,227 @@
+#ifndef ALLOCATORS_HPP
+# define ALLOCATORS_HPP
+
+# include <cstddef>
+# include <cstdlib>
+# include <limits>
+# include <new>
+# include <stdint.h>
+# include <sys/mman.h>
+
+# include "memory.hpp"
+
+// Tells the compiler that a block just allocated aliases nothing else, as
+// it already assumes for operator new; without it, a loop that reads a
+// buffer and writes anywhere else reloads on every step. The function
+// stays out of line: once inlined, the attribute is lost and the compiler
+// only sees an mmap result.
+# if defined(__GNUG__)
+#  define FT_FRESH_BLOCK __attribute__((__malloc__, __noinline__))
+# else
+#  define FT_FRESH_BLOCK
+# endif
+
+namespace ft {
+
+// Allocator whose blocks start on an Align-byte boundary, a cache line by
+// default, so that SIMD loads over a vector's buffer never straddle one at
+// the start.
+template <class T, size_t Align = 64>
+class aligned_allocator
+{
+    static_assert(Align && !(Align & (Align - 1)), "aligned_allocator alignment must be a power of two");
+    static_assert(Align >= alignof(T), "aligned_allocator alignment below alignof(T)");
+    static_assert(Align >= sizeof(void*), "aligned_allocator alignment below sizeof(void*)");
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    static const size_t alignment = Align;
+
+    template <class U>
+    struct rebind
+    {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+    aligned_allocator()
+    {}
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&)
+    {}
+
+    FT_FRESH_BLOCK
+    pointer     allocate(size_type n, const void* = nullptr)
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+        // aligned_alloc wants a whole number of alignment units.
+        size_t  bytes = (n * sizeof(T) + Align - 1) / Align * Align;
+        void*   p = ::aligned_alloc(Align, bytes ? bytes : Align);
+        if (!p)
+            throw std::bad_alloc();
+        return (static_cast<pointer>(p));
+    }
+
+    void        deallocate(pointer p, size_type)
+    { std::free(p); }
+
+    void        construct(pointer p, const T& value)
+    { ::new (static_cast<void*>(p)) T(value); }
+
+    void        destroy(pointer p)
+    { p->~T(); }
+
+    pointer     address(reference x) const
+    { return (&x); }
+
+    const_pointer   address(const_reference x) const
+    { return (&x); }
+
+    size_type   max_size() const
+    { return ((std::numeric_limits<size_type>::max() - Align) / sizeof(T)); }
+};
+
+template <class T, class U, size_t Align>
+bool    operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&)
+{ return (true); }
+
+template <class T, class U, size_t Align>
+bool    operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&)
+{ return (false); }
+
+template <class T, size_t Align>
+struct allocation_size<aligned_allocator<T, Align> >
+{
+    static const bool exact = true;
+
+    static size_t   reserved(const void* p, size_t requested)
+    { return (accounting_allocator<char>::block_size(p, requested)); }
+};
+
+// Allocator that puts large blocks on transparent huge pages. A block of
+// at least huge_page_size bytes gets an anonymous mapping of its own,
+// rounded to and aligned on whole huge pages and marked MADV_HUGEPAGE, so
+// that a scan over it needs one TLB entry per 2 MiB instead of per 4 KiB.
+// Where the kernel does not do huge pages the hint is ignored and the
+// mapping uses ordinary pages. Smaller blocks come from malloc.
+template <class T>
+class hugepage_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    static const size_t huge_page_size = size_t(2) << 20;
+
+    template <class U>
+    struct rebind
+    {
+        typedef hugepage_allocator<U>   other;
+    };
+
+    hugepage_allocator()
+    {}
+
+    template <class U>
+    hugepage_allocator(const hugepage_allocator<U>&)
+    {}
+
+    // Bytes a block of `bytes` really takes when it is mapped.
+    static size_t   mapped_size(size_t bytes)
+    { return ((bytes + huge_page_size - 1) / huge_page_size * huge_page_size); }
+
+    FT_FRESH_BLOCK
+    pointer     allocate(size_type n, const void* = nullptr)
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+        size_t  bytes = n * sizeof(T);
+        if (bytes < huge_page_size)
+        {
+            void*   p = std::malloc(bytes ? bytes : 1);
+            if (!p)
+                throw std::bad_alloc();
+            return (static_cast<pointer>(p));
+        }
+        // Map one huge page more than needed and trim both ends so that
+        // the block starts on a huge page boundary.
+        size_t  size = mapped_size(bytes);
+        char*   raw = static_cast<char*>(::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE,
+                                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc();
+        char*   p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(raw) + huge_page_size - 1)
+                                            & ~uintptr_t(huge_page_size - 1));
+        if (p != raw)
+            ::munmap(raw, p - raw);
+        if (size_t tail = (raw + size + huge_page_size) - (p + size))
+            ::munmap(p + size, tail);
+# ifdef MADV_HUGEPAGE
+        ::madvise(p, size, MADV_HUGEPAGE);
+# endif
+        return (reinterpret_cast<pointer>(p));
+    }
+
+    void        deallocate(pointer p, size_type n)
+    {
+        if (!p)
+            return ;
+        size_t  bytes = n * sizeof(T);
+        if (bytes < huge_page_size)
+            std::free(p);
+        else
+            ::munmap(p, mapped_size(bytes));
+    }
+
+    void        construct(pointer p, const T& value)
+    { ::new (static_cast<void*>(p)) T(value); }
+
+    void        destroy(pointer p)
+    { p->~T(); }
+
+    pointer     address(reference x) const
+    { return (&x); }
+
+    const_pointer   address(const_reference x) const
+    { return (&x); }
+
+    size_type   max_size() const
+    { return ((std::numeric_limits<size_type>::max() - huge_page_size) / sizeof(T)); }
+};
+
+template <class T, class U>
+bool    operator==(const hugepage_allocator<T>&, const hugepage_allocator<U>&)
+{ return (true); }
+
+template <class T, class U>
+bool    operator!=(const hugepage_allocator<T>&, const hugepage_allocator<U>&)
+{ return (false); }
+
+template <class T>
+struct allocation_size<hugepage_allocator<T> >
+{
+    static const bool exact = true;
+
+    static size_t   reserved(const void* p, size_t requested)
+    {
+        if (requested < hugepage_allocator<T>::huge_page_size)
+            return (accounting_allocator<char>::block_size(p, requested));
+        return (hugepage_allocator<T>::mapped_size(requested));
+    }
+};
+
+}
+
+#endif
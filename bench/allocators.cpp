@@ -0,0 +1,85 @@
+#include "harness.hpp"
+
+#include "allocators.hpp"
+#include "vector.hpp"
+
+namespace bench {
+
+namespace {
+
+// The same vector over the default, the cache-line aligned and the huge
+// page allocator. The last two bypass operator new, so their allocs and
+// alloc_bytes columns stay at zero.
+typedef ft::vector<uint64_t>                                        plain_vector;
+typedef ft::vector<uint64_t, ft::aligned_allocator<uint64_t> >      aligned_vector;
+typedef ft::vector<uint64_t, ft::hugepage_allocator<uint64_t> >     hugepage_vector;
+
+// Allocating and writing every element: most of the time goes to page
+// faults, one per 4 KiB page or one per huge page.
+template <class V>
+void    fill(state& s)
+{
+    size_t  r = reps(s.size(), 100000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        s.start();
+        V   v(s.size(), uint64_t(k));
+        keep(v);
+        s.stop(s.size());
+    }
+}
+
+// A sequential pass; the prefetcher hides most TLB misses here.
+template <class V>
+void    scan(state& s)
+{
+    V       v(s.size(), 1);
+    size_t  r = reps(s.size());
+    uint64_t    sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (typename V::const_iterator it = v.begin(); it != v.end(); ++it)
+            sum += *it;
+    s.stop(r * v.size());
+    keep(sum);
+}
+
+// Reads at scattered indices: once the buffer outgrows what the TLB maps
+// with 4 KiB pages, nearly every read also walks the page table.
+template <class V>
+void    random_read(state& s)
+{
+    V           v(s.size(), 1);
+    size_t      ops = 10000000;
+    uint64_t    sum = 0;
+    uint64_t    x = 88172645463325252ull;
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        sum += v[x % v.size()];
+    }
+    s.stop(ops);
+    keep(sum);
+}
+
+void    add_op(const char* op, case_fn plain, case_fn aligned, case_fn hugepage)
+{
+    add("allocator", op, "u64", "std_alloc", plain, 100000000);
+    add("allocator", op, "u64", "aligned64", aligned, 100000000);
+    add("allocator", op, "u64", "hugepage", hugepage, 100000000);
+}
+
+}
+
+void    register_allocators()
+{
+    add_op("fill", &fill<plain_vector>, &fill<aligned_vector>, &fill<hugepage_vector>);
+    add_op("scan", &scan<plain_vector>, &scan<aligned_vector>, &scan<hugepage_vector>);
+    add_op("random_read", &random_read<plain_vector>, &random_read<aligned_vector>,
+           &random_read<hugepage_vector>);
+}
+
+}
@@ -0,0 +1,82 @@
+#include "harness.hpp"
+
+#include <mutex>
+#include <stack>
+#include <thread>
+
+#include "concurrent_stack.hpp"
+
+namespace bench {
+
+namespace {
+
+// A std::stack behind one mutex: the obvious alternative.
+class locked_stack
+{
+    std::mutex      _lock;
+    std::stack<int> _stack;
+public:
+    explicit locked_stack(size_t)
+    {}
+
+    bool    push(int x)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stack.push(x);
+        return (true);
+    }
+
+    bool    pop(int& x)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_stack.empty())
+            return (false);
+        x = _stack.top();
+        _stack.pop();
+        return (true);
+    }
+};
+
+// size() push/pop pairs in total, split across Threads threads that each
+// push one value and pop one back.
+template <class S, unsigned Threads>
+void    push_pop(state& s)
+{
+    S       st(Threads * 2);
+    size_t  per_thread = s.size() / Threads;
+    s.start();
+    std::thread workers[Threads];
+    for (unsigned t = 0; t < Threads; ++t)
+        workers[t] = std::thread([&st, per_thread, t] {
+            int v = 0;
+            for (size_t i = 0; i < per_thread; ++i)
+            {
+                st.push(int(i + t));
+                while (!st.pop(v))
+                    ;
+            }
+            keep(v);
+        });
+    for (unsigned t = 0; t < Threads; ++t)
+        workers[t].join();
+    s.stop(per_thread * Threads);
+}
+
+template <unsigned Threads>
+void    add_threads(const char* op)
+{
+    add("concurrent_stack", op, "int", "ft", &push_pop<ft::concurrent_stack<int>, Threads>);
+    add("concurrent_stack", op, "int", "std_mutex", &push_pop<locked_stack, Threads>);
+}
+
+}
+
+void    register_concurrent_stack()
+{
+    add_threads<1>("push_pop_1t");
+    add_threads<2>("push_pop_2t");
+    add_threads<4>("push_pop_4t");
+    add_threads<8>("push_pop_8t");
+}
+
+}
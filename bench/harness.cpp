@@ -0,0 +1,266 @@
+// ft_bench: runs every registered case in a forked child, one size at a
+// time, and prints one CSV row per implementation:
+//
+//   suite,op,type,impl,size,ops,ns_per_op,allocs,alloc_bytes,peak_rss_kb,status
+//
+// allocs and alloc_bytes count operator new calls inside the timed region.
+// peak_rss_kb is the child's maximum resident set, generated input included.
+
+#include "harness.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<size_t> g_allocs(0);
+std::atomic<size_t> g_alloc_bytes(0);
+
+void*   counted_new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    void*   p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return (p);
+}
+
+struct bench_case
+{
+    const char*     suite;
+    const char*     op;
+    const char*     type;
+    const char*     impl;
+    bench::case_fn  fn;
+    size_t          max_size;
+};
+
+std::vector<bench_case>&    registry()
+{
+    static std::vector<bench_case>  cases;
+    return (cases);
+}
+
+bool    same_group(const bench_case& a, const bench_case& b)
+{
+    return (!std::strcmp(a.suite, b.suite) && !std::strcmp(a.op, b.op)
+            && !std::strcmp(a.type, b.type));
+}
+
+bool    selected(const bench_case& c, const char* filter)
+{
+    if (!filter)
+        return (true);
+    std::string name = std::string(c.suite) + "/" + c.op + "/" + c.type + "/" + c.impl;
+    return (name.find(filter) != std::string::npos);
+}
+
+// Runs one case in a child process so that its peak RSS is its own and a
+// crash or an out-of-memory kill only costs that row.
+bool    run_child(const bench_case& c, size_t n, bench::result& r, long& peak_kb, int& status)
+{
+    int fds[2];
+    if (pipe(fds))
+        return (false);
+    std::fflush(stdout);
+    pid_t   pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return (false);
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        bench::state    s(n);
+        c.fn(s);
+        bench::result   out = s.get();
+        ssize_t         written = write(fds[1], &out, sizeof(out));
+        _exit(written == ssize_t(sizeof(out)) ? 0 : 1);
+    }
+    close(fds[1]);
+    ssize_t got = read(fds[0], &r, sizeof(r));
+    close(fds[0]);
+    struct rusage   usage;
+    std::memset(&usage, 0, sizeof(usage));
+    wait4(pid, &status, 0, &usage);
+    peak_kb = usage.ru_maxrss;
+    return (got == ssize_t(sizeof(r)) && WIFEXITED(status) && !WEXITSTATUS(status));
+}
+
+void    run(const bench_case& c, size_t n, unsigned repeat)
+{
+    bench::result   best = bench::result();
+    long            best_peak = 0;
+    bool            ok = false;
+    int             status = 0;
+    for (unsigned i = 0; i < repeat; ++i)
+    {
+        bench::result   r;
+        long            peak = 0;
+        if (!run_child(c, n, r, peak, status))
+        {
+            ok = false;
+            break ;
+        }
+        if (!ok || r.ns / r.ops < best.ns / best.ops)
+        {
+            best = r;
+            best_peak = peak;
+        }
+        ok = true;
+    }
+    if (ok)
+        std::printf("%s,%s,%s,%s,%zu,%zu,%.3f,%zu,%zu,%ld,ok\n",
+                    c.suite, c.op, c.type, c.impl, n, best.ops,
+                    best.ns / best.ops, best.allocs, best.alloc_bytes, best_peak);
+    else if (WIFSIGNALED(status))
+        std::printf("%s,%s,%s,%s,%zu,,,,,,signal %d\n",
+                    c.suite, c.op, c.type, c.impl, n, WTERMSIG(status));
+    else
+        std::printf("%s,%s,%s,%s,%zu,,,,,,failed\n", c.suite, c.op, c.type, c.impl, n);
+    std::fflush(stdout);
+}
+
+void    usage(const char* name)
+{
+    std::fprintf(stderr,
+        "usage: %s [--filter TEXT] [--min-size N] [--max-size N] [--repeat N] [--list]\n"
+        "  --filter TEXT  only cases whose suite/op/type/impl contains TEXT\n"
+        "  --min-size N   smallest size to run (default 100)\n"
+        "  --max-size N   largest size to run (default 10000000)\n"
+        "  --repeat N     runs per row, the fastest is reported (default 1)\n"
+        "  --list         print the cases and exit\n", name);
+}
+
+}
+
+void*   operator new(size_t size)
+{ return (counted_new(size)); }
+
+void*   operator new[](size_t size)
+{ return (counted_new(size)); }
+
+void    operator delete(void* p) noexcept
+{ std::free(p); }
+
+void    operator delete[](void* p) noexcept
+{ std::free(p); }
+
+void    operator delete(void* p, size_t) noexcept
+{ std::free(p); }
+
+void    operator delete[](void* p, size_t) noexcept
+{ std::free(p); }
+
+namespace bench {
+
+state::state(size_t n) : _n(n), _allocs(0), _bytes(0)
+{
+    std::memset(&_result, 0, sizeof(_result));
+}
+
+void    state::start()
+{
+    _allocs = g_allocs.load(std::memory_order_relaxed);
+    _bytes = g_alloc_bytes.load(std::memory_order_relaxed);
+    _start = clock::now();
+}
+
+void    state::stop(size_t ops)
+{
+    clock::time_point   end = clock::now();
+    _result.ns += std::chrono::duration<double, std::nano>(end - _start).count();
+    _result.ops += ops;
+    _result.allocs += g_allocs.load(std::memory_order_relaxed) - _allocs;
+    _result.alloc_bytes += g_alloc_bytes.load(std::memory_order_relaxed) - _bytes;
+}
+
+void    add(const char* suite, const char* op, const char* type, const char* impl,
+            case_fn fn, size_t max_size)
+{
+    bench_case  c = { suite, op, type, impl, fn, max_size };
+    registry().push_back(c);
+}
+
+}
+
+int     main(int argc, char** argv)
+{
+    const char* filter = nullptr;
+    size_t      min_size = 100;
+    size_t      max_size = 10000000;
+    unsigned    repeat = 1;
+    bool        list = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--list")
+            list = true;
+        else if (i + 1 < argc && arg == "--filter")
+            filter = argv[++i];
+        else if (i + 1 < argc && arg == "--min-size")
+            min_size = std::strtoull(argv[++i], nullptr, 10);
+        else if (i + 1 < argc && arg == "--max-size")
+            max_size = std::strtoull(argv[++i], nullptr, 10);
+        else if (i + 1 < argc && arg == "--repeat")
+            repeat = unsigned(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            usage(argv[0]);
+            return (arg == "--help" ? 0 : 2);
+        }
+    }
+    if (!repeat)
+        repeat = 1;
+
+    bench::register_vector();
+    bench::register_map();
+    bench::register_threaded_tree();
+    bench::register_stack();
+    bench::register_unordered_map();
+    bench::register_concurrent_stack();
+    bench::register_allocators();
+
+    const std::vector<bench_case>&  cases = registry();
+    if (list)
+    {
+        for (size_t i = 0; i < cases.size(); ++i)
+            std::printf("%s/%s/%s/%s\n", cases[i].suite, cases[i].op, cases[i].type, cases[i].impl);
+        return (0);
+    }
+
+    std::printf("suite,op,type,impl,size,ops,ns_per_op,allocs,alloc_bytes,peak_rss_kb,status\n");
+    std::vector<bool>   done(cases.size(), false);
+    for (size_t g = 0; g < cases.size(); ++g)
+    {
+        if (done[g])
+            continue ;
+        // Every implementation of this suite/op/type, in registration order.
+        std::vector<size_t> group;
+        for (size_t i = g; i < cases.size(); ++i)
+            if (!done[i] && same_group(cases[g], cases[i]))
+            {
+                done[i] = true;
+                if (selected(cases[i], filter))
+                    group.push_back(i);
+            }
+        for (size_t n = 100; n <= max_size; n *= 10)
+        {
+            if (n < min_size)
+                continue ;
+            for (size_t i = 0; i < group.size(); ++i)
+                if (n <= cases[group[i]].max_size)
+                    run(cases[group[i]], n, repeat);
+        }
+    }
+    return (0);
+}
@@ -0,0 +1,153 @@
+#ifndef BENCH_HARNESS_HPP
+# define BENCH_HARNESS_HPP
+
+# include <chrono>
+# include <cstddef>
+# include <cstdint>
+# include <cstdio>
+# include <cstring>
+# include <string>
+# include <vector>
+
+namespace bench {
+
+// What one run of a case reports back to the parent process.
+struct result
+{
+    double  ns;
+    size_t  ops;
+    size_t  allocs;
+    size_t  alloc_bytes;
+};
+
+// Passed to every case. Only the code between start() and stop() is timed
+// and has its allocations counted; a case may start and stop several times
+// and the totals add up.
+class state
+{
+    typedef std::chrono::steady_clock   clock;
+
+    size_t              _n;
+    result              _result;
+    clock::time_point   _start;
+    size_t              _allocs;
+    size_t              _bytes;
+public:
+    explicit state(size_t n);
+
+    size_t  size() const
+    { return (_n); }
+
+    const result&   get() const
+    { return (_result); }
+
+    void    start();
+    void    stop(size_t ops);
+};
+
+typedef void    (*case_fn)(state&);
+
+// Registers one implementation of suite/op/type. Rows sharing suite, op and
+// type are printed next to each other for every size up to max_size.
+void    add(const char* suite, const char* op, const char* type, const char* impl,
+            case_fn fn, size_t max_size = 10000000);
+
+void    register_vector();
+void    register_map();
+void    register_threaded_tree();
+void    register_stack();
+void    register_unordered_map();
+void    register_concurrent_stack();
+void    register_allocators();
+
+// Keeps the compiler from discarding a result that is never read.
+template <class T>
+inline void keep(const T& x)
+{
+    asm volatile("" : : "g"(&x) : "memory");
+}
+
+// Element type large enough that copies, not pointer chasing, dominate.
+struct large_pod
+{
+    uint64_t    key;
+    char        pad[248];
+};
+
+inline bool operator<(const large_pod& a, const large_pod& b)
+{ return (a.key < b.key); }
+
+inline bool operator==(const large_pod& a, const large_pod& b)
+{ return (a.key == b.key); }
+
+inline bool operator!=(const large_pod& a, const large_pod& b)
+{ return (a.key != b.key); }
+
+// Distinct for distinct i below 2^32, in no particular order, so that
+// inserting make<T>(0), make<T>(1), ... lands all over a tree.
+inline uint32_t scramble(size_t i)
+{
+    return (uint32_t(i * 2654435761u));
+}
+
+template <class T>
+T       make(size_t i);
+
+template <>
+inline int  make<int>(size_t i)
+{
+    return (int(scramble(i)));
+}
+
+// Long enough to live on the heap with every common small-string buffer.
+template <>
+inline std::string make<std::string>(size_t i)
+{
+    char    buf[48];
+    std::snprintf(buf, sizeof(buf), "key-%08x-%010zu", scramble(i), i);
+    return (std::string(buf));
+}
+
+template <>
+inline large_pod    make<large_pod>(size_t i)
+{
+    large_pod   p;
+    p.key = scramble(i);
+    std::memset(p.pad, int(i), sizeof(p.pad));
+    return (p);
+}
+
+template <class T>
+std::vector<T>  make_range(size_t first, size_t n)
+{
+    std::vector<T>  v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(make<T>(first + i));
+    return (v);
+}
+
+// Something to fold while iterating, so that every element is read.
+inline size_t   weight(int x)
+{ return (size_t(x)); }
+
+inline size_t   weight(const std::string& x)
+{ return (x.size()); }
+
+inline size_t   weight(const large_pod& x)
+{ return (size_t(x.key)); }
+
+template <class A, class B>
+inline size_t   weight(const A& key, const B&)
+{ return (weight(key)); }
+
+// Repetitions that bring a cheap per-element pass up to about `budget`
+// element visits, so small sizes are not lost in timer resolution.
+inline size_t   reps(size_t n, size_t budget = 10000000)
+{
+    return (n && n < budget ? budget / n : 1);
+}
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "map_cases.hpp"
+
+#include <map>
+
+#include "map.hpp"
+
+namespace bench {
+
+namespace {
+
+template <class K>
+void    add_type(const char* type, size_t max_size)
+{
+    typedef ft::map<K, int>     ft_map;
+    typedef std::map<K, int>    std_map;
+
+    add("map", "insert", type, "ft", &map_cases::insert<ft_map>, max_size);
+    add("map", "insert", type, "std", &map_cases::insert<std_map>, max_size);
+    add("map", "erase", type, "ft", &map_cases::erase<ft_map>, max_size);
+    add("map", "erase", type, "std", &map_cases::erase<std_map>, max_size);
+    add("map", "iterate", type, "ft", &map_cases::iterate<ft_map>, max_size);
+    add("map", "iterate", type, "std", &map_cases::iterate<std_map>, max_size);
+    add("map", "find", type, "ft", &map_cases::find<ft_map>, max_size);
+    add("map", "find", type, "std", &map_cases::find<std_map>, max_size);
+    add("map", "lower_bound", type, "ft", &map_cases::lower_bound<ft_map>, max_size);
+    add("map", "lower_bound", type, "std", &map_cases::lower_bound<std_map>, max_size);
+    add("map", "churn", type, "ft", &map_cases::churn<ft_map>, max_size);
+    add("map", "churn", type, "std", &map_cases::churn<std_map>, max_size);
+    add("map", "copy", type, "ft", &map_cases::copy<ft_map>, max_size);
+    add("map", "copy", type, "std", &map_cases::copy<std_map>, max_size);
+    add("map", "clear", type, "ft", &map_cases::clear<ft_map>, max_size);
+    add("map", "clear", type, "std", &map_cases::clear<std_map>, max_size);
+}
+
+}
+
+void    register_map()
+{
+    add_type<int>("int", 10000000);
+    add_type<std::string>("string", 10000000);
+    add_type<large_pod>("pod256", 1000000);
+}
+
+}
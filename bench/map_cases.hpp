@@ -0,0 +1,163 @@
+#ifndef BENCH_MAP_CASES_HPP
+# define BENCH_MAP_CASES_HPP
+
+# include "harness.hpp"
+
+// Cases shared by every map-like container: M is filled with keys
+// make<key_type>(0 .. n) mapped to their index.
+namespace bench {
+namespace map_cases {
+
+template <class M>
+void    fill(M& m, const std::vector<typename M::key_type>& keys)
+{
+    for (size_t i = 0; i < keys.size(); ++i)
+        m.insert(typename M::value_type(keys[i], int(i)));
+}
+
+template <class M>
+void    insert(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    M               m;
+    s.start();
+    fill(m, keys);
+    s.stop(keys.size());
+    keep(m);
+}
+
+template <class M>
+void    erase(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    M               m;
+    fill(m, keys);
+    s.start();
+    for (size_t i = 0; i < keys.size(); ++i)
+        m.erase(keys[i]);
+    s.stop(keys.size());
+    keep(m);
+}
+
+template <class M>
+void    iterate(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    M               m;
+    fill(m, keys);
+    const M&        cm = m;
+    size_t          r = reps(s.size());
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (typename M::const_iterator it = cm.begin(); it != cm.end(); ++it)
+            sum += weight(it->first, it->second);
+    s.stop(r * keys.size());
+    keep(sum);
+}
+
+template <class M>
+void    find(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    M               m;
+    fill(m, keys);
+    size_t          r = reps(s.size(), 1000000);
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (size_t i = 0; i < keys.size(); ++i)
+            sum += m.find(keys[i])->second;
+    s.stop(r * keys.size());
+    keep(sum);
+}
+
+// Looks up keys that are not in the map, so every search runs to a leaf.
+template <class M>
+void    lower_bound(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    std::vector<K>  misses = make_range<K>(s.size(), s.size());
+    M               m;
+    fill(m, keys);
+    size_t          r = reps(s.size(), 1000000);
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (size_t i = 0; i < misses.size(); ++i)
+            sum += m.lower_bound(misses[i]) == m.end();
+    s.stop(r * misses.size());
+    keep(sum);
+}
+
+// Erases one key and inserts a fresh one per op, at a constant size.
+template <class M>
+void    churn(state& s)
+{
+    typedef typename M::key_type    K;
+
+    size_t          ops = s.size() < 1000000 ? s.size() : 1000000;
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    std::vector<K>  fresh = make_range<K>(s.size(), ops);
+    M               m;
+    fill(m, keys);
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+    {
+        m.erase(keys[i]);
+        m.insert(typename M::value_type(fresh[i], int(i)));
+    }
+    s.stop(ops);
+    keep(m);
+}
+
+template <class M>
+void    copy(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    M               m;
+    fill(m, keys);
+    size_t          r = reps(s.size(), 1000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        s.start();
+        M   c(m);
+        keep(c);
+        s.stop(keys.size());
+    }
+}
+
+template <class M>
+void    clear(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    size_t          r = reps(s.size(), 1000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        M   m;
+        fill(m, keys);
+        s.start();
+        m.clear();
+        s.stop(keys.size());
+        keep(m);
+    }
+}
+
+}
+}
+
+#endif
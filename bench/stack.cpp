@@ -0,0 +1,117 @@
+#include "harness.hpp"
+
+#include <stack>
+#include <vector>
+
+#include "deque.hpp"
+#include "stack.hpp"
+
+namespace bench {
+
+namespace {
+
+template <class S>
+void    push(state& s)
+{
+    typedef typename S::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    S               st;
+    s.start();
+    for (size_t i = 0; i < in.size(); ++i)
+        st.push(in[i]);
+    s.stop(in.size());
+    keep(st);
+}
+
+template <class S>
+void    pop(state& s)
+{
+    typedef typename S::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    S               st;
+    for (size_t i = 0; i < in.size(); ++i)
+        st.push(in[i]);
+    size_t          sum = 0;
+    s.start();
+    while (!st.empty())
+    {
+        sum += weight(st.top());
+        st.pop();
+    }
+    s.stop(in.size());
+    keep(sum);
+}
+
+// Two pushes and a pop per step: the stack keeps growing, but the top
+// moves back and forth like in a depth-first walk.
+template <class S>
+void    churn(state& s)
+{
+    typedef typename S::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    S               st;
+    s.start();
+    for (size_t i = 0; i + 1 < in.size(); i += 2)
+    {
+        st.push(in[i]);
+        st.push(in[i + 1]);
+        st.pop();
+    }
+    s.stop(in.size() / 2 * 3);
+    keep(st);
+}
+
+template <class S>
+void    copy(state& s)
+{
+    typedef typename S::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    S               st;
+    for (size_t i = 0; i < in.size(); ++i)
+        st.push(in[i]);
+    size_t          r = reps(s.size(), 1000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        s.start();
+        S   c(st);
+        keep(c);
+        s.stop(in.size());
+    }
+}
+
+// ft_deque is the same ft::stack over ft::deque instead of ft::vector.
+template <class T>
+void    add_type(const char* type, size_t max_size)
+{
+    typedef ft::stack<T>                    ft_stack;
+    typedef ft::stack<T, ft::deque<T> >     ft_deque_stack;
+    typedef std::stack<T>                   std_stack;
+
+    add("stack", "push", type, "ft", &push<ft_stack>, max_size);
+    add("stack", "push", type, "ft_deque", &push<ft_deque_stack>, max_size);
+    add("stack", "push", type, "std", &push<std_stack>, max_size);
+    add("stack", "pop", type, "ft", &pop<ft_stack>, max_size);
+    add("stack", "pop", type, "ft_deque", &pop<ft_deque_stack>, max_size);
+    add("stack", "pop", type, "std", &pop<std_stack>, max_size);
+    add("stack", "churn", type, "ft", &churn<ft_stack>, max_size);
+    add("stack", "churn", type, "ft_deque", &churn<ft_deque_stack>, max_size);
+    add("stack", "churn", type, "std", &churn<std_stack>, max_size);
+    add("stack", "copy", type, "ft", &copy<ft_stack>, max_size);
+    add("stack", "copy", type, "ft_deque", &copy<ft_deque_stack>, max_size);
+    add("stack", "copy", type, "std", &copy<std_stack>, max_size);
+}
+
+}
+
+void    register_stack()
+{
+    add_type<int>("int", 10000000);
+    add_type<std::string>("string", 10000000);
+    add_type<large_pod>("pod256", 1000000);
+}
+
+}
@@ -0,0 +1,51 @@
+// map/iterate with the in-order links of FT_THREADED_TREE, printed next to
+// the plain ft and std rows. node<T> changes layout under the macro, so the
+// keys here are types local to this file: no tree instantiation is shared
+// with the translation units built without it.
+#define FT_THREADED_TREE
+
+#include "map_cases.hpp"
+
+#include "map.hpp"
+
+namespace bench {
+
+namespace {
+
+template <class T>
+struct threaded_key
+{
+    T   value;
+};
+
+template <class T>
+bool    operator<(const threaded_key<T>& a, const threaded_key<T>& b)
+{ return (a.value < b.value); }
+
+template <class T>
+size_t  weight(const threaded_key<T>& x)
+{ return (bench::weight(x.value)); }
+
+}
+
+template <>
+threaded_key<int>   make<threaded_key<int> >(size_t i)
+{
+    threaded_key<int>   k = { make<int>(i) };
+    return (k);
+}
+
+template <>
+threaded_key<std::string>   make<threaded_key<std::string> >(size_t i)
+{
+    threaded_key<std::string>   k = { make<std::string>(i) };
+    return (k);
+}
+
+void    register_threaded_tree()
+{
+    add("map", "iterate", "int", "ft_threaded", &map_cases::iterate<ft::map<threaded_key<int>, int> >);
+    add("map", "iterate", "string", "ft_threaded", &map_cases::iterate<ft::map<threaded_key<std::string>, int> >);
+}
+
+}
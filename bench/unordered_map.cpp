@@ -0,0 +1,197 @@
+#include "map_cases.hpp"
+
+#include <map>
+#include <unordered_map>
+
+#include "map.hpp"
+#include "unordered_map.hpp"
+
+namespace bench {
+
+namespace {
+
+template <class M>
+void    find_miss(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys = make_range<K>(0, s.size());
+    std::vector<K>  misses = make_range<K>(s.size(), s.size());
+    M               m;
+    map_cases::fill(m, keys);
+    size_t          r = reps(s.size(), 1000000);
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (size_t i = 0; i < misses.size(); ++i)
+            sum += m.find(misses[i]) == m.end();
+    s.stop(r * misses.size());
+    keep(sum);
+}
+
+// Gives m a capacity of `slots` that filling will not grow. The cap on
+// ft::unordered_map's factor is 15/16, above every load swept below; the
+// tree has no table to size.
+template <class K>
+void    set_slots(ft::unordered_map<K, int>& m, size_t slots)
+{
+    m.max_load_factor(15.f / 16.f);
+    m.rehash(slots);
+}
+
+template <class K>
+void    set_slots(std::unordered_map<K, int>& m, size_t slots)
+{
+    m.max_load_factor(1.f);
+    m.rehash(slots);
+}
+
+template <class K>
+void    set_slots(ft::map<K, int>&, size_t)
+{}
+
+// The table gets the smallest power-of-two capacity not below the case
+// size and is filled to Permille thousandths of it, so that every
+// implementation runs the same keys and the hash tables sit at the same
+// load.
+inline size_t  slots_for(const state& s)
+{
+    size_t  slots = 16;
+    while (slots < s.size())
+        slots *= 2;
+    return (slots);
+}
+
+template <class M, size_t Permille>
+void    fill_to_load(M& m, const state& s, std::vector<typename M::key_type>& keys)
+{
+    size_t  slots = slots_for(s);
+    keys = make_range<typename M::key_type>(0, slots * Permille / 1000);
+    set_slots(m, slots);
+    map_cases::fill(m, keys);
+}
+
+template <class M, size_t Permille>
+void    find_at_load(state& s)
+{
+    std::vector<typename M::key_type>   keys;
+    M                                   m;
+    fill_to_load<M, Permille>(m, s, keys);
+    size_t  r = reps(keys.size(), 1000000);
+    size_t  sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (size_t i = 0; i < keys.size(); ++i)
+            sum += m.find(keys[i])->second;
+    s.stop(r * keys.size());
+    keep(sum);
+}
+
+template <class M, size_t Permille>
+void    find_miss_at_load(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys;
+    M               m;
+    fill_to_load<M, Permille>(m, s, keys);
+    std::vector<K>  misses = make_range<K>(keys.size(), keys.size());
+    size_t          r = reps(misses.size(), 1000000);
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (size_t i = 0; i < misses.size(); ++i)
+            sum += m.find(misses[i]) == m.end();
+    s.stop(r * misses.size());
+    keep(sum);
+}
+
+// Erase one key, insert a fresh one: the load stays put while tombstones
+// pile up in the open-addressed table.
+template <class M, size_t Permille>
+void    churn_at_load(state& s)
+{
+    typedef typename M::key_type    K;
+
+    std::vector<K>  keys;
+    M               m;
+    fill_to_load<M, Permille>(m, s, keys);
+    size_t          ops = keys.size() < 1000000 ? keys.size() : 1000000;
+    std::vector<K>  fresh = make_range<K>(keys.size(), ops);
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+    {
+        m.erase(keys[i]);
+        m.insert(typename M::value_type(fresh[i], int(i)));
+    }
+    s.stop(ops);
+    keep(m);
+}
+
+// find, find_miss and churn with the tables Permille thousandths full; the
+// tree runs the same keys as a baseline. type names the key and the load,
+// e.g. int@0.75.
+template <class K, size_t Permille>
+void    add_load(const char* type)
+{
+    typedef ft::unordered_map<K, int>   ft_hash;
+    typedef ft::map<K, int>             ft_map;
+    typedef std::unordered_map<K, int>  std_hash;
+
+    add("unordered_map", "find", type, "ft", &find_at_load<ft_hash, Permille>);
+    add("unordered_map", "find", type, "ft_map", &find_at_load<ft_map, Permille>);
+    add("unordered_map", "find", type, "std", &find_at_load<std_hash, Permille>);
+    add("unordered_map", "find_miss", type, "ft", &find_miss_at_load<ft_hash, Permille>);
+    add("unordered_map", "find_miss", type, "ft_map", &find_miss_at_load<ft_map, Permille>);
+    add("unordered_map", "find_miss", type, "std", &find_miss_at_load<std_hash, Permille>);
+    add("unordered_map", "churn", type, "ft", &churn_at_load<ft_hash, Permille>);
+    add("unordered_map", "churn", type, "ft_map", &churn_at_load<ft_map, Permille>);
+    add("unordered_map", "churn", type, "std", &churn_at_load<std_hash, Permille>);
+}
+
+// The same operations on the open-addressed table, the tree it would
+// replace, and the standard node-based table.
+template <class K>
+void    add_type(const char* type)
+{
+    typedef ft::unordered_map<K, int>   ft_hash;
+    typedef ft::map<K, int>             ft_map;
+    typedef std::unordered_map<K, int>  std_hash;
+
+    add("unordered_map", "insert", type, "ft", &map_cases::insert<ft_hash>);
+    add("unordered_map", "insert", type, "ft_map", &map_cases::insert<ft_map>);
+    add("unordered_map", "insert", type, "std", &map_cases::insert<std_hash>);
+    add("unordered_map", "find", type, "ft", &map_cases::find<ft_hash>);
+    add("unordered_map", "find", type, "ft_map", &map_cases::find<ft_map>);
+    add("unordered_map", "find", type, "std", &map_cases::find<std_hash>);
+    add("unordered_map", "find_miss", type, "ft", &find_miss<ft_hash>);
+    add("unordered_map", "find_miss", type, "ft_map", &find_miss<ft_map>);
+    add("unordered_map", "find_miss", type, "std", &find_miss<std_hash>);
+    add("unordered_map", "erase", type, "ft", &map_cases::erase<ft_hash>);
+    add("unordered_map", "erase", type, "ft_map", &map_cases::erase<ft_map>);
+    add("unordered_map", "erase", type, "std", &map_cases::erase<std_hash>);
+    add("unordered_map", "churn", type, "ft", &map_cases::churn<ft_hash>);
+    add("unordered_map", "churn", type, "ft_map", &map_cases::churn<ft_map>);
+    add("unordered_map", "churn", type, "std", &map_cases::churn<std_hash>);
+    add("unordered_map", "iterate", type, "ft", &map_cases::iterate<ft_hash>);
+    add("unordered_map", "iterate", type, "ft_map", &map_cases::iterate<ft_map>);
+    add("unordered_map", "iterate", type, "std", &map_cases::iterate<std_hash>);
+}
+
+}
+
+void    register_unordered_map()
+{
+    add_type<int>("int");
+    add_type<std::string>("string");
+    add_load<int, 250>("int@0.25");
+    add_load<int, 500>("int@0.5");
+    add_load<int, 750>("int@0.75");
+    add_load<int, 875>("int@0.875");
+    add_load<std::string, 250>("string@0.25");
+    add_load<std::string, 500>("string@0.5");
+    add_load<std::string, 750>("string@0.75");
+    add_load<std::string, 875>("string@0.875");
+}
+
+}
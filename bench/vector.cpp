@@ -0,0 +1,143 @@
+#include "harness.hpp"
+
+#include <vector>
+
+#include "vector.hpp"
+
+namespace bench {
+
+namespace {
+
+// Middle inserts and erases move half the vector each; this keeps the
+// total work per row near 10^7 element moves.
+size_t  middle_ops(size_t n)
+{
+    size_t  ops = 10000000 / n;
+    return (ops < 1 ? 1 : ops > 1000 ? 1000 : ops);
+}
+
+template <class V>
+void    push_back(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    V               v;
+    s.start();
+    for (size_t i = 0; i < in.size(); ++i)
+        v.push_back(in[i]);
+    s.stop(in.size());
+    keep(v);
+}
+
+template <class V>
+void    insert_middle(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    V               v(in.begin(), in.end());
+    size_t          ops = middle_ops(s.size());
+    T               x = make<T>(s.size());
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+        v.insert(v.begin() + v.size() / 2, x);
+    s.stop(ops);
+    keep(v);
+}
+
+template <class V>
+void    erase_middle(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    V               v(in.begin(), in.end());
+    size_t          ops = middle_ops(s.size());
+    if (ops > v.size())
+        ops = v.size();
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+        v.erase(v.begin() + v.size() / 2);
+    s.stop(ops);
+    keep(v);
+}
+
+template <class V>
+void    iterate(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    const V         v(in.begin(), in.end());
+    size_t          r = reps(s.size());
+    size_t          sum = 0;
+    s.start();
+    for (size_t k = 0; k < r; ++k)
+        for (typename V::const_iterator it = v.begin(); it != v.end(); ++it)
+            sum += weight(*it);
+    s.stop(r * v.size());
+    keep(sum);
+}
+
+template <class V>
+void    copy(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    const V         v(in.begin(), in.end());
+    size_t          r = reps(s.size(), 1000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        s.start();
+        V   c(v);
+        keep(c);
+        s.stop(v.size());
+    }
+}
+
+template <class V>
+void    clear(state& s)
+{
+    typedef typename V::value_type  T;
+
+    std::vector<T>  in = make_range<T>(0, s.size());
+    size_t          r = reps(s.size(), 1000000);
+    for (size_t k = 0; k < r; ++k)
+    {
+        V   v(in.begin(), in.end());
+        s.start();
+        v.clear();
+        s.stop(in.size());
+        keep(v);
+    }
+}
+
+template <class T>
+void    add_type(const char* type, size_t max_size)
+{
+    add("vector", "push_back", type, "ft", &push_back<ft::vector<T> >, max_size);
+    add("vector", "push_back", type, "std", &push_back<std::vector<T> >, max_size);
+    add("vector", "insert_middle", type, "ft", &insert_middle<ft::vector<T> >, max_size);
+    add("vector", "insert_middle", type, "std", &insert_middle<std::vector<T> >, max_size);
+    add("vector", "erase_middle", type, "ft", &erase_middle<ft::vector<T> >, max_size);
+    add("vector", "erase_middle", type, "std", &erase_middle<std::vector<T> >, max_size);
+    add("vector", "iterate", type, "ft", &iterate<ft::vector<T> >, max_size);
+    add("vector", "iterate", type, "std", &iterate<std::vector<T> >, max_size);
+    add("vector", "copy", type, "ft", &copy<ft::vector<T> >, max_size);
+    add("vector", "copy", type, "std", &copy<std::vector<T> >, max_size);
+    add("vector", "clear", type, "ft", &clear<ft::vector<T> >, max_size);
+    add("vector", "clear", type, "std", &clear<std::vector<T> >, max_size);
+}
+
+}
+
+void    register_vector()
+{
+    add_type<int>("int", 10000000);
+    add_type<std::string>("string", 10000000);
+    add_type<large_pod>("pod256", 1000000);
+}
+
+}
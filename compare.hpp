@@ -0,0 +1,74 @@
+#ifndef COMPARE_HPP
+# define COMPARE_HPP
+
+# include <functional>
+# include <string>
+# include <type_traits>
+# include <utility>
+
+namespace ft {
+
+// Whether Compare can order two keys with a single call, and how.
+// value is true when Compare has a member
+//
+//     int compare(const Key& a, const Key& b) const;
+//
+// returning a negative number, zero or a positive number as a sorts
+// before, with or after b, consistently with its operator(). std::less
+// and std::greater over std::string qualify through basic_string::compare.
+// compare() works either way; without a three-way member it costs two
+// calls to the comparator.
+template <class Compare, class Key>
+struct three_way_compare
+{
+private:
+    template <class C, class = decltype(std::declval<const C&>().compare(std::declval<const Key&>(),
+                                                                        std::declval<const Key&>()))>
+    static char test(int);
+    template <class C>
+    static long test(...);
+
+    static int  order(const Compare& comp, const Key& a, const Key& b, std::true_type)
+    { return (comp.compare(a, b)); }
+
+    static int  order(const Compare& comp, const Key& a, const Key& b, std::false_type)
+    { return (comp(a, b) ? -1 : comp(b, a) ? 1 : 0); }
+public:
+    static const bool value = sizeof(test<Compare>(0)) == 1;
+
+    static int  compare(const Compare& comp, const Key& a, const Key& b)
+    { return (order(comp, a, b, std::integral_constant<bool, value>())); }
+};
+
+template <class Compare, class Key>
+const bool  three_way_compare<Compare, Key>::value;
+
+template <class C, class T, class A>
+struct three_way_compare<std::less<std::basic_string<C, T, A> >, std::basic_string<C, T, A> >
+{
+    static const bool value = true;
+
+    static int  compare(const std::less<std::basic_string<C, T, A> >&,
+                        const std::basic_string<C, T, A>& a, const std::basic_string<C, T, A>& b)
+    { return (a.compare(b)); }
+};
+
+template <class C, class T, class A>
+struct three_way_compare<std::greater<std::basic_string<C, T, A> >, std::basic_string<C, T, A> >
+{
+    static const bool value = true;
+
+    static int  compare(const std::greater<std::basic_string<C, T, A> >&,
+                        const std::basic_string<C, T, A>& a, const std::basic_string<C, T, A>& b)
+    { return (b.compare(a)); }
+};
+
+template <class C, class T, class A>
+const bool  three_way_compare<std::less<std::basic_string<C, T, A> >, std::basic_string<C, T, A> >::value;
+
+template <class C, class T, class A>
+const bool  three_way_compare<std::greater<std::basic_string<C, T, A> >, std::basic_string<C, T, A> >::value;
+
+}
+
+#endif
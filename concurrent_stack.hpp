@@ -0,0 +1,213 @@
+#ifndef CONCURRENT_STACK_HPP
+# define CONCURRENT_STACK_HPP
+
+# include <memory>
+# include <atomic>
+# include <new>
+# include <stdexcept>
+# include <stdint.h>
+
+namespace ft {
+
+// Lock-free LIFO (Treiber stack) over a node pool allocated once up front.
+// push and pop never lock and never allocate: they move nodes between the
+// pool's free list and the stack list with a single CAS each.
+//
+// Both list heads are 64-bit words holding a 32-bit node index and a 32-bit
+// tag bumped by every successful CAS, which rules out ABA. Nodes are only
+// released with the stack itself, so a thread reading the link of a node
+// that was popped under it reads valid memory and just fails its CAS.
+template <typename T, typename Alloc = std::allocator<T> >
+class concurrent_stack
+{
+public:
+    typedef T                                           value_type;
+    typedef Alloc                                       allocator_type;
+    typedef size_t                                      size_type;
+private:
+    struct slot
+    {
+        std::atomic<uint32_t>                                       next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type  storage;
+
+        T*  value(void)
+        { return (reinterpret_cast<T*>(&storage)); }
+    };
+    typedef typename Alloc::template rebind<slot>::other    slot_allocator;
+
+    enum { cache_line = 64 };
+
+    alignas(cache_line) std::atomic<uint64_t>  _head;
+    alignas(cache_line) std::atomic<uint64_t>  _free;
+    alignas(cache_line) slot*                  _slots;
+    size_type                                   _capacity;
+    slot_allocator                              _alloc;
+
+    concurrent_stack(const concurrent_stack&);
+    concurrent_stack&   operator=(const concurrent_stack&);
+
+    static uint32_t index(uint64_t word)
+    { return (static_cast<uint32_t>(word)); }
+
+    static uint64_t pack(uint32_t index, uint64_t old)
+    { return ((((old >> 32) + 1) << 32) | index); }
+
+    slot&   at(uint32_t index)
+    { return (_slots[index - 1]); }
+
+    uint32_t    take(std::atomic<uint64_t>& head)
+    {
+        uint64_t    old = head.load(std::memory_order_acquire);
+        for (;;)
+        {
+            uint32_t    idx = index(old);
+            if (!idx)
+                return (0);
+            uint32_t    next = at(idx).next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(next, old), std::memory_order_acq_rel, std::memory_order_acquire))
+                return (idx);
+        }
+    }
+
+    void    give(std::atomic<uint64_t>& head, uint32_t first, uint32_t last)
+    {
+        uint64_t    old = head.load(std::memory_order_relaxed);
+        do {
+            at(last).next.store(index(old), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(first, old), std::memory_order_release, std::memory_order_relaxed));
+    }
+public:
+    explicit concurrent_stack(size_type capacity, const allocator_type& alloc = allocator_type())
+    : _head(0), _free(0), _slots(nullptr), _capacity(capacity), _alloc(alloc)
+    {
+        if (capacity >= UINT32_MAX)
+            throw std::length_error("concurrent_stack");
+        if (!capacity)
+            return ;
+        _slots = _alloc.allocate(capacity);
+        for (size_type i = 0; i < capacity; ++i)
+            ::new (static_cast<void*>(&_slots[i].next)) std::atomic<uint32_t>(i + 1 < capacity ? i + 2 : 0);
+        _free.store(1);
+    }
+
+    ~concurrent_stack()
+    {
+        for (uint32_t idx = index(_head.load()); idx; idx = at(idx).next.load())
+            at(idx).value()->~T();
+        if (_slots)
+            _alloc.deallocate(_slots, _capacity);
+    }
+
+    // Returns false when every node of the pool is in use.
+    bool    push(const value_type& value)
+    {
+        uint32_t    idx = take(_free);
+        if (!idx)
+            return (false);
+        try {
+            ::new (static_cast<void*>(at(idx).value())) T(value);
+        } catch (...) {
+            give(_free, idx, idx);
+            throw ;
+        }
+        give(_head, idx, idx);
+        return (true);
+    }
+
+    bool    pop(value_type& value)
+    {
+        uint32_t    idx = take(_head);
+        if (!idx)
+            return (false);
+        T*  p = at(idx).value();
+        try {
+            value = *p;
+        } catch (...) {
+            // The element was not consumed: back onto the stack with it.
+            give(_head, idx, idx);
+            throw ;
+        }
+        p->~T();
+        give(_free, idx, idx);
+        return (true);
+    }
+
+    // Links the elements into a private chain and publishes it with one CAS,
+    // so they land on the stack contiguously with the last one on top.
+    // Stops early when the pool runs dry; returns how many were pushed.
+    template <class InputIterator>
+    size_type   push_range(InputIterator first, InputIterator last)
+    {
+        uint32_t    top = 0;
+        uint32_t    bottom = 0;
+        size_type   n = 0;
+        for ( ; first != last; ++first, ++n)
+        {
+            uint32_t    idx = take(_free);
+            if (!idx)
+                break ;
+            try {
+                ::new (static_cast<void*>(at(idx).value())) T(*first);
+            } catch (...) {
+                give(_free, idx, idx);
+                if (top)
+                    give(_head, top, bottom);
+                throw ;
+            }
+            at(idx).next.store(top, std::memory_order_relaxed);
+            if (!top)
+                bottom = idx;
+            top = idx;
+        }
+        if (top)
+            give(_head, top, bottom);
+        return (n);
+    }
+
+    // Detaches the whole stack with one CAS and writes it out top first.
+    template <class OutputIterator>
+    OutputIterator  pop_all(OutputIterator out)
+    {
+        uint64_t    old = _head.load(std::memory_order_acquire);
+        while (index(old) && !_head.compare_exchange_weak(old, pack(0, old), std::memory_order_acq_rel, std::memory_order_acquire))
+            ;
+        uint32_t    top = index(old);
+        uint32_t    last = 0;
+        uint32_t    idx = top;
+        try {
+            for ( ; idx; idx = at(idx).next.load(std::memory_order_relaxed))
+            {
+                T*  p = at(idx).value();
+                *out = *p;
+                ++out;
+                p->~T();
+                last = idx;
+            }
+        } catch (...) {
+            // What was written out is freed; the rest goes back on the stack.
+            if (last)
+                give(_free, top, last);
+            uint32_t    bottom = idx;
+            while (uint32_t next = at(bottom).next.load(std::memory_order_relaxed))
+                bottom = next;
+            give(_head, idx, bottom);
+            throw ;
+        }
+        if (top)
+            give(_free, top, last);
+        return (out);
+    }
+
+    bool        empty() const
+    { return (!index(_head.load(std::memory_order_acquire))); }
+
+    size_type   capacity() const
+    { return (_capacity); }
+
+    allocator_type  get_allocator() const
+    { return (allocator_type(_alloc)); }
+};
+
+}
+
+#endif
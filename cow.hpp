@@ -0,0 +1,413 @@
+#ifndef COW_HPP
+# define COW_HPP
+
+# include <atomic>
+# include <cstddef>
+# include <memory>
+# include <stdexcept>
+
+# include "vector.hpp"
+# include "map.hpp"
+# include "utils.hpp"
+
+namespace ft {
+
+// Copy-on-write handle to a Container. Copies share one reference-counted
+// instance, so copying costs a counter increment whatever the size; the
+// first write() through a handle that shares clones the container for it
+// alone. The count is atomic: handles sharing an instance may live in, be
+// read from and be dropped by different threads. One handle, like any
+// container, must not be written from two threads at once.
+//
+// A reference or iterator obtained through write() stays valid only
+// until the handle is next copied; after that, the next write() clones
+// again and the old reference points into the shared copy.
+template <class Container>
+class cow
+{
+    struct block
+    {
+        std::atomic<size_t> refs;
+        Container           c;
+
+        block() : refs(1), c()
+        {}
+
+        explicit block(const Container& x) : refs(1), c(x)
+        {}
+    };
+
+    block*  _b;
+
+    void    release()
+    {
+        if (_b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete _b;
+    }
+public:
+    typedef Container   container_type;
+
+    cow() : _b(new block())
+    {}
+
+    explicit cow(const Container& c) : _b(new block(c))
+    {}
+
+    cow(const cow& x) : _b(x._b)
+    { _b->refs.fetch_add(1, std::memory_order_relaxed); }
+
+    ~cow()
+    { release(); }
+
+    cow&    operator=(const cow& x)
+    {
+        if (_b != x._b)
+        {
+            x._b->refs.fetch_add(1, std::memory_order_relaxed);
+            release();
+            _b = x._b;
+        }
+        return (*this);
+    }
+
+    const Container&    read() const
+    { return (_b->c); }
+
+    // The container, made private to this handle first if it is shared.
+    Container&          write()
+    {
+        if (shared())
+        {
+            block*  b = new block(_b->c);
+            release();
+            _b = b;
+        }
+        return (_b->c);
+    }
+
+    bool                shared() const
+    { return (_b->refs.load(std::memory_order_acquire) > 1); }
+
+    size_t              use_count() const
+    { return (_b->refs.load(std::memory_order_acquire)); }
+
+    void                swap(cow& x)
+    { ft::swap(_b, x._b); }
+};
+
+// ft::vector behind a cow handle. Reads go to the shared buffer; every
+// member that can modify the vector goes through write(). Iteration is
+// const only; positions are turned into indices before the buffer is
+// cloned, so an iterator taken from a shared buffer may still be passed
+// to insert and erase.
+template <class T, class Alloc = std::allocator<T> >
+class cow_vector : public cow<vector<T, Alloc> >
+{
+    typedef cow<vector<T, Alloc> >  base;
+public:
+    typedef vector<T, Alloc>                            vector_type;
+    typedef typename vector_type::value_type            value_type;
+    typedef typename vector_type::allocator_type        allocator_type;
+    typedef typename vector_type::reference             reference;
+    typedef typename vector_type::const_reference       const_reference;
+    typedef typename vector_type::const_iterator        const_iterator;
+    typedef typename vector_type::const_iterator        iterator;
+    typedef typename vector_type::const_reverse_iterator    const_reverse_iterator;
+    typedef typename vector_type::const_reverse_iterator    reverse_iterator;
+    typedef typename vector_type::difference_type       difference_type;
+    typedef typename vector_type::size_type             size_type;
+
+    using base::read;
+    using base::write;
+private:
+    size_type   index_of(const_iterator position) const
+    { return (size_type(position - read().begin())); }
+public:
+    cow_vector()
+    {}
+
+    explicit cow_vector(const vector_type& v) : base(v)
+    {}
+
+    explicit cow_vector(size_type n, const value_type& val = value_type()) : base(vector_type(n, val))
+    {}
+
+    template <class InputIterator>
+    cow_vector(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    : base(vector_type(first, last))
+    {}
+
+    const_iterator          begin() const
+    { return (read().begin()); }
+    const_iterator          end() const
+    { return (read().end()); }
+    const_reverse_iterator  rbegin() const
+    { return (read().rbegin()); }
+    const_reverse_iterator  rend() const
+    { return (read().rend()); }
+
+    size_type   size() const
+    { return (read().size()); }
+
+    size_type   max_size() const
+    { return (read().max_size()); }
+
+    size_type   capacity() const
+    { return (read().capacity()); }
+
+    bool        empty() const
+    { return (read().empty()); }
+
+    const_reference operator[](size_type n) const
+    { return (read()[n]); }
+
+    reference       operator[](size_type n)
+    { return (write()[n]); }
+
+    const_reference at(size_type n) const
+    { return (read().at(n)); }
+
+    reference       at(size_type n)
+    {
+        if (n >= size())
+            throw std::out_of_range("vector");
+        return (write()[n]);
+    }
+
+    const_reference front() const
+    { return (read().front()); }
+    const_reference back() const
+    { return (read().back()); }
+
+    const value_type*   data() const
+    { return (read().data()); }
+
+    void        reserve(size_type n)
+    {
+        if (n > capacity())
+            write().reserve(n);
+    }
+
+    void        resize(size_type n, value_type val = value_type())
+    { write().resize(n, val); }
+
+    void        assign(size_type n, const value_type& val)
+    { write().assign(n, val); }
+
+    template <class InputIterator>
+    void        assign(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    { write().assign(first, last); }
+
+    void        push_back(const value_type& val)
+    { write().push_back(val); }
+
+    void        pop_back()
+    { write().pop_back(); }
+
+    iterator    insert(const_iterator position, const value_type& val)
+    {
+        size_type   index = index_of(position);
+        write().insert(write().begin() + index, val);
+        return (begin() + index);
+    }
+
+    void        insert(const_iterator position, size_type n, const value_type& val)
+    {
+        size_type   index = index_of(position);
+        write().insert(write().begin() + index, n, val);
+    }
+
+    template <class InputIterator>
+    void        insert(const_iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type first, InputIterator last)
+    {
+        size_type   index = index_of(position);
+        write().insert(write().begin() + index, first, last);
+    }
+
+    iterator    erase(const_iterator position)
+    { return (erase(position, position + 1)); }
+
+    iterator    erase(const_iterator first, const_iterator last)
+    {
+        size_type   index = index_of(first);
+        size_type   n = size_type(last - first);
+        write().erase(write().begin() + index, write().begin() + index + n);
+        return (begin() + index);
+    }
+
+    // Drops this handle's share instead of clearing a buffer others use.
+    void        clear()
+    {
+        if (this->shared())
+            base::operator=(base());
+        else
+            write().clear();
+    }
+};
+
+template <class T, class Alloc>
+bool    operator==(const cow_vector<T, Alloc>& x, const cow_vector<T, Alloc>& y)
+{ return (&x.read() == &y.read() || x.read() == y.read()); }
+
+template <class T, class Alloc>
+bool    operator!=(const cow_vector<T, Alloc>& x, const cow_vector<T, Alloc>& y)
+{ return (!(x == y)); }
+
+template <class T, class Alloc>
+bool    operator<(const cow_vector<T, Alloc>& x, const cow_vector<T, Alloc>& y)
+{ return (x.read() < y.read()); }
+
+template <class T, class Alloc>
+void    swap(cow_vector<T, Alloc>& x, cow_vector<T, Alloc>& y)
+{ x.swap(y); }
+
+// ft::map behind a cow handle: copying a map of any size is O(1), and the
+// tree is cloned on the first modification of a shared copy. Iterators
+// are const; erase(pos) goes by the key at pos, so it works on a
+// position taken before the tree was cloned.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<pair<const Key, T> > >
+class cow_map : public cow<map<Key, T, Compare, Allocator> >
+{
+    typedef cow<map<Key, T, Compare, Allocator> >   base;
+public:
+    typedef map<Key, T, Compare, Allocator>             map_type;
+    typedef typename map_type::key_type                 key_type;
+    typedef typename map_type::mapped_type              mapped_type;
+    typedef typename map_type::value_type               value_type;
+    typedef typename map_type::size_type                size_type;
+    typedef typename map_type::difference_type          difference_type;
+    typedef typename map_type::key_compare              key_compare;
+    typedef typename map_type::allocator_type           allocator_type;
+    typedef typename map_type::const_iterator           const_iterator;
+    typedef typename map_type::const_iterator           iterator;
+    typedef typename map_type::const_reverse_iterator   const_reverse_iterator;
+    typedef typename map_type::const_reverse_iterator   reverse_iterator;
+
+    using base::read;
+    using base::write;
+
+    cow_map()
+    {}
+
+    explicit cow_map(const map_type& m) : base(m)
+    {}
+
+    template <class InputIterator>
+    cow_map(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    : base(map_type(first, last))
+    {}
+
+    const_iterator          begin() const
+    { return (read().begin()); }
+    const_iterator          end() const
+    { return (read().end()); }
+    const_reverse_iterator  rbegin() const
+    { return (read().rbegin()); }
+    const_reverse_iterator  rend() const
+    { return (read().rend()); }
+
+    size_type   size() const
+    { return (read().size()); }
+
+    size_type   max_size() const
+    { return (read().max_size()); }
+
+    bool        empty() const
+    { return (read().empty()); }
+
+    key_compare key_comp() const
+    { return (read().key_comp()); }
+
+    const_iterator  find(const key_type& k) const
+    { return (read().find(k)); }
+
+    size_type       count(const key_type& k) const
+    { return (read().count(k)); }
+
+    const_iterator  lower_bound(const key_type& k) const
+    { return (read().lower_bound(k)); }
+
+    const_iterator  upper_bound(const key_type& k) const
+    { return (read().upper_bound(k)); }
+
+    pair<const_iterator, const_iterator>    equal_range(const key_type& k) const
+    { return (read().equal_range(k)); }
+
+    const mapped_type&  at(const key_type& k) const
+    { return (read().at(k)); }
+
+    mapped_type&        at(const key_type& k)
+    {
+        if (find(k) == end())
+            throw std::out_of_range("map::at:  key not found");
+        return (write().at(k));
+    }
+
+    mapped_type&        operator[](const key_type& k)
+    { return (write()[k]); }
+
+    // Leaves a shared tree alone when the key is already there.
+    pair<iterator, bool>    insert(const value_type& value)
+    {
+        const_iterator  it = find(value.first);
+        if (it != end())
+            return (ft::make_pair(it, false));
+        pair<typename map_type::iterator, bool> res = write().insert(value);
+        return (ft::make_pair(const_iterator(res.first), res.second));
+    }
+
+    iterator    insert(const_iterator hint, const value_type& value)
+    {
+        (void)hint;
+        return (insert(value).first);
+    }
+
+    template <class InputIterator>
+    void        insert(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    { write().insert(first, last); }
+
+    void        erase(const_iterator pos)
+    {
+        key_type    k = pos->first;
+        erase(k);
+    }
+
+    void        erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+            erase(first++);
+    }
+
+    size_type   erase(const key_type& k)
+    {
+        if (find(k) == end())
+            return (0);
+        return (write().erase(k));
+    }
+
+    // Drops this handle's share instead of clearing a tree others use.
+    void        clear()
+    {
+        if (this->shared())
+            base::operator=(base());
+        else
+            write().clear();
+    }
+};
+
+template <class Key, class T, class Compare, class Allocator>
+bool    operator==(const cow_map<Key, T, Compare, Allocator>& x, const cow_map<Key, T, Compare, Allocator>& y)
+{ return (&x.read() == &y.read() || x.read() == y.read()); }
+
+template <class Key, class T, class Compare, class Allocator>
+bool    operator!=(const cow_map<Key, T, Compare, Allocator>& x, const cow_map<Key, T, Compare, Allocator>& y)
+{ return (!(x == y)); }
+
+template <class Key, class T, class Compare, class Allocator>
+void    swap(cow_map<Key, T, Compare, Allocator>& x, cow_map<Key, T, Compare, Allocator>& y)
+{ x.swap(y); }
+
+}
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef DEQUE_HPP
+# define DEQUE_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+
+# include "DequeIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "memory.hpp"
+
+namespace ft {
+
+// Double-ended queue over a map of fixed-size blocks. Element g (counting
+// from the start of the map) lives in block g / block_size; only blocks that
+// hold elements are allocated, and a block is released as soon as the last
+// element in it is popped. Pushing never relocates existing elements, only
+// the map of block pointers is reallocated when one end runs out of room.
+template <typename T, typename Alloc = std::allocator<T> >
+class deque
+{
+public:
+    typedef T                                                   value_type;
+    typedef Alloc                                               allocator_type;
+    typedef typename allocator_type::reference                  reference;
+    typedef typename allocator_type::pointer                    pointer;
+    typedef typename allocator_type::const_reference            const_reference;
+    typedef typename allocator_type::const_pointer              const_pointer;
+    typedef DequeIterator<value_type, false>                    iterator;
+    typedef DequeIterator<value_type, true>                     const_iterator;
+    typedef ReverseRIterator<iterator>                          reverse_iterator;
+    typedef ReverseRIterator<const_iterator>                    const_reverse_iterator;
+    typedef ptrdiff_t                                           difference_type;
+    typedef size_t                                              size_type;
+private:
+    typedef typename Alloc::template rebind<pointer>::other    map_allocator;
+
+    enum { block_size = deque_block<T>::size };
+    enum { min_map_size = 8 };
+
+    pointer*        _map;
+    size_type       _map_size;
+    size_type       _off;
+    size_type       _sz;
+    allocator_type  _alloc;
+    map_allocator   _map_alloc;
+
+    pointer&    block(size_type g)
+    { return (_map[g / block_size]); }
+
+    pointer     slot(size_type g) const
+    { return (_map[g / block_size] + g % block_size); }
+
+    void    allocate_block(size_type g)
+    {
+        if (!block(g))
+            block(g) = _alloc.allocate(block_size);
+    }
+
+    void    deallocate_block(size_type g)
+    {
+        _alloc.deallocate(block(g), block_size);
+        block(g) = nullptr;
+    }
+
+    // Moves the used blocks to the middle of a map large enough for `front`
+    // more blocks before them and `back` more after the end block.
+    void    reserve_map(size_type front, size_type back)
+    {
+        size_type   first = _off / block_size;
+        size_type   used = _map ? (_off + _sz) / block_size - first + 1 : 1;
+        size_type   need = used + front + back;
+        if (_map && first >= front && (_off + _sz) / block_size + back < _map_size)
+            return ;
+
+        size_type   new_size = std::max<size_type>(min_map_size, std::max(need * 2, _map_size));
+        pointer*    new_map = _map_alloc.allocate(new_size);
+        std::fill(new_map, new_map + new_size, pointer());
+        size_type   new_first = (new_size - need) / 2 + front;
+        if (_map)
+        {
+            std::copy(_map + first, _map + first + used, new_map + new_first);
+            _map_alloc.deallocate(_map, _map_size);
+        }
+        _off = new_first * block_size + _off % block_size;
+        _map = new_map;
+        _map_size = new_size;
+    }
+
+    void    release(void)
+    {
+        clear();
+        if (_map)
+        {
+            for (size_type i = 0; i < _map_size; ++i)
+                if (_map[i])
+                    _alloc.deallocate(_map[i], block_size);
+            _map_alloc.deallocate(_map, _map_size);
+        }
+        _map = nullptr;
+        _map_size = 0;
+        _off = 0;
+    }
+public:
+    deque (const allocator_type& alloc = allocator_type())
+    : _map(nullptr), _map_size(0), _off(0), _sz(0), _alloc(alloc), _map_alloc(alloc)
+    {}
+
+    explicit deque (size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+    : _map(nullptr), _map_size(0), _off(0), _sz(0), _alloc(alloc), _map_alloc(alloc)
+    {
+        assign(n, val);
+    }
+
+    template < class InputIterator >
+    deque (typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type first, InputIterator last, const allocator_type& alloc = allocator_type())
+    : _map(nullptr), _map_size(0), _off(0), _sz(0), _alloc(alloc), _map_alloc(alloc)
+    {
+        assign(first, last);
+    }
+
+    deque (const deque& x)
+    : _map(nullptr), _map_size(0), _off(0), _sz(0), _alloc(x._alloc), _map_alloc(x._map_alloc)
+    {
+        assign(x.begin(), x.end());
+    }
+
+    ~deque()
+    {
+        release();
+    }
+
+    deque&  operator= (const deque& x)
+    {
+        if (this != &x)
+            assign(x.begin(), x.end());
+        return (*this);
+    }
+
+    void    assign (size_type n, const value_type& val)
+    {
+        clear();
+        for ( ; n; --n)
+            push_back(val);
+    }
+
+    template < class InputIterator >
+    void    assign (InputIterator first, typename ft::enable_if<ft::is_input_iterator< InputIterator >::value, InputIterator >::type last)
+    {
+        clear();
+        for ( ; first != last; ++first)
+            push_back(*first);
+    }
+
+    iterator                begin (void)
+    { return (_map ? iterator(_map + _off / block_size, _off % block_size) : iterator()); }
+    const_iterator          begin (void) const
+    { return (_map ? const_iterator(_map + _off / block_size, _off % block_size) : const_iterator()); }
+    iterator                end (void)
+    { return (_map ? iterator(_map + (_off + _sz) / block_size, (_off + _sz) % block_size) : iterator()); }
+    const_iterator          end (void) const
+    { return (_map ? const_iterator(_map + (_off + _sz) / block_size, (_off + _sz) % block_size) : const_iterator()); }
+    reverse_iterator        rbegin (void)
+    { return (end()); }
+    const_reverse_iterator  rbegin (void) const
+    { return (end()); }
+    reverse_iterator        rend (void)
+    { return (begin()); }
+    const_reverse_iterator  rend (void) const
+    { return (begin()); }
+
+    size_type   size() const
+    { return (_sz); }
+
+    size_type   max_size() const
+    { return (_alloc.max_size()); }
+
+    bool        empty(void) const
+    { return (!_sz); }
+
+    void resize (size_type n, value_type val = value_type ())
+    {
+        while (_sz > n)
+            pop_back();
+        while (_sz < n)
+            push_back(val);
+    }
+
+    reference       operator [] (size_type n)
+    { return (*slot(_off + n)); }
+
+    const_reference operator [] (size_type n) const
+    { return (*slot(_off + n)); }
+
+    reference at (size_type n)
+    {
+        if (n >= _sz)
+            throw std::out_of_range("deque");
+        return (*slot(_off + n));
+    }
+
+    const_reference at (size_type n) const
+    {
+        if (n >= _sz)
+            throw std::out_of_range("deque");
+        return (*slot(_off + n));
+    }
+
+    reference       front()
+    { return (*slot(_off)); }
+    const_reference front() const
+    { return (*slot(_off)); }
+    reference       back()
+    { return (*slot(_off + _sz - 1)); }
+    const_reference back() const
+    { return (*slot(_off + _sz - 1)); }
+
+    void push_back (const value_type& val)
+    {
+        reserve_map(0, (_off + _sz + 1) % block_size ? 0 : 1);
+        size_type   g = _off + _sz;
+        allocate_block(g);
+        _alloc.construct(slot(g), val);
+        ++_sz;
+    }
+
+    void push_front (const value_type& val)
+    {
+        reserve_map(_off % block_size ? 0 : 1, 0);
+        size_type   g = _off - 1;
+        allocate_block(g);
+        _alloc.construct(slot(g), val);
+        _off = g;
+        ++_sz;
+    }
+
+    void pop_back (void)
+    {
+        size_type   g = _off + --_sz;
+        _alloc.destroy(slot(g));
+        if (!_sz || g % block_size == 0)
+            deallocate_block(g);
+    }
+
+    void pop_front (void)
+    {
+        size_type   g = _off++;
+        --_sz;
+        _alloc.destroy(slot(g));
+        if (!_sz || _off % block_size == 0)
+            deallocate_block(g);
+    }
+
+    iterator insert (iterator position, const value_type& val)
+    {
+        difference_type index = position - begin();
+        insert(position, 1, val);
+        return (begin() + index);
+    }
+
+    void insert (iterator position, size_type n, const value_type& val)
+    {
+        difference_type index = position - begin();
+        if (size_type(index) < _sz / 2)
+        {
+            for (size_type i = 0; i < n; ++i)
+                push_front(val);
+            std::rotate(begin(), begin() + n, begin() + n + index);
+        }
+        else
+        {
+            size_type   old_sz = _sz;
+            for (size_type i = 0; i < n; ++i)
+                push_back(val);
+            std::rotate(begin() + index, begin() + old_sz, end());
+        }
+    }
+
+    template < class InputIterator >
+    void insert (iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value,InputIterator>::type first, InputIterator last)
+    {
+        difference_type index = position - begin();
+        size_type       old_sz = _sz;
+        for ( ; first != last; ++first)
+            push_back(*first);
+        std::rotate(begin() + index, begin() + old_sz, end());
+    }
+
+    iterator erase (iterator position)
+    {
+        iterator    next = position;
+        return (erase(position, ++next));
+    }
+
+    iterator erase (iterator first, iterator last)
+    {
+        difference_type index = first - begin();
+        difference_type n = last - first;
+        if (index < difference_type(_sz) - index - n)
+        {
+            std::copy_backward(begin(), first, last);
+            for ( ; n; --n)
+                pop_front();
+        }
+        else
+        {
+            std::copy(last, end(), first);
+            for ( ; n; --n)
+                pop_back();
+        }
+        return (begin() + index);
+    }
+
+    void swap (deque& x)
+    {
+        ft::swap(_map, x._map);
+        ft::swap(_map_size, x._map_size);
+        ft::swap(_off, x._off);
+        ft::swap(_sz, x._sz);
+        ft::swap(_alloc, x._alloc);
+        ft::swap(_map_alloc, x._map_alloc);
+    }
+
+    void        clear(void)
+    {
+        while (_sz)
+            pop_back();
+    }
+
+    allocator_type get_allocator() const
+    {
+        return (_alloc);
+    }
+
+    // The block map plus every allocated block; the unused slots at either
+    // end of the first and last blocks count as overhead. Scans the map.
+    memory_report   memory_usage() const
+    {
+        memory_report   r;
+        r.elements = _sz;
+        r.payload = _sz * sizeof(value_type);
+        r.requested = _map_size * sizeof(pointer);
+        r.reserved = _map ? allocation_size<map_allocator>::reserved(_map, r.requested) : 0;
+        for (size_type i = 0; i < _map_size; ++i)
+            if (_map[i])
+            {
+                r.requested += block_size * sizeof(value_type);
+                r.reserved += allocation_size<allocator_type>::reserved(_map[i], block_size * sizeof(value_type));
+            }
+        r.header = sizeof(*this);
+        return (r);
+    }
+};
+
+template < class T, class Alloc >
+bool operator< (const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return ft::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template < class T, class Alloc >
+bool operator==(const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return v1.size() == v2.size() && ft::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template < class T, class Alloc >
+bool operator!=(const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return !operator==(v1, v2);
+}
+
+template < class T, class Alloc >
+bool operator<=(const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return (!operator<(v2, v1));
+}
+
+template < class T, class Alloc >
+bool operator> (const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return operator<(v2, v1);
+}
+
+template < class T, class Alloc >
+bool operator>=(const deque<T,Alloc>& v1, const deque<T,Alloc> & v2)
+{
+    return (!operator<(v1, v2));
+}
+
+template < class T, class Alloc >
+void swap(deque<T,Alloc>& x, deque<T,Alloc> & y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
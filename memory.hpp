@@ -0,0 +1,185 @@
+#ifndef MEMORY_HPP
+# define MEMORY_HPP
+
+# include <atomic>
+# include <cstddef>
+# include <cstdlib>
+# include <limits>
+# include <new>
+# if defined(__GLIBC__)
+#  include <malloc.h>
+# endif
+
+namespace ft {
+
+// What a container costs beyond its elements. payload is what the elements
+// themselves occupy; requested is what the container asked its allocator
+// for (slack capacity, node links and colours, sentinels); reserved is
+// what the allocator really set aside for those requests; header is the
+// container object itself.
+struct memory_report
+{
+    size_t  elements;
+    size_t  payload;
+    size_t  requested;
+    size_t  reserved;
+    size_t  header;
+
+    // Bytes per element that are not the element itself.
+    double  overhead_per_element() const
+    {
+        if (!elements)
+            return (0);
+        return (double(reserved + header - payload) / double(elements));
+    }
+
+    // Share of the reserved bytes that the allocator added on top of the
+    // requests: size-class rounding and chunk headers.
+    double  fragmentation() const
+    {
+        if (!reserved)
+            return (0);
+        return (double(reserved - requested) / double(reserved));
+    }
+};
+
+// Tells a container how many bytes its allocator really reserved for a
+// block. Without better knowledge, that is what was asked for.
+template <class Alloc>
+struct allocation_size
+{
+    static const bool exact = false;
+
+    static size_t   reserved(const void*, size_t requested)
+    { return (requested); }
+};
+
+// Running totals over every accounting_allocator, whatever its type.
+struct accounting_totals
+{
+    std::atomic<size_t> allocations;
+    std::atomic<size_t> deallocations;
+    std::atomic<size_t> requested;      // bytes live right now
+    std::atomic<size_t> reserved;
+    std::atomic<size_t> peak_reserved;
+
+    accounting_totals() : allocations(0), deallocations(0), requested(0), reserved(0), peak_reserved(0)
+    {}
+};
+
+inline accounting_totals&   accounting_allocator_totals()
+{
+    static accounting_totals    totals;
+    return (totals);
+}
+
+// malloc-backed allocator that keeps accounting_totals up to date and lets
+// containers see how much each of their blocks really occupies.
+template <class T>
+class accounting_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef accounting_allocator<U>   other;
+    };
+
+    accounting_allocator()
+    {}
+
+    template <class U>
+    accounting_allocator(const accounting_allocator<U>&)
+    {}
+
+    // Shared by every accounting_allocator, whatever its value type.
+    static accounting_totals&   totals()
+    { return (accounting_allocator_totals()); }
+
+    // Bytes malloc set aside for p: the usable size, which is rounded up to
+    // a size class, plus the size word glibc keeps in front of each chunk.
+    static size_t   block_size(const void* p, size_t requested)
+    {
+# if defined(__GLIBC__)
+        (void)requested;
+        return (p ? malloc_usable_size(const_cast<void*>(p)) + sizeof(size_t) : 0);
+# else
+        (void)p;
+        return (requested);
+# endif
+    }
+
+    pointer     allocate(size_type n, const void* = nullptr)
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+        size_t  bytes = n * sizeof(T);
+        pointer p = static_cast<pointer>(std::malloc(bytes ? bytes : 1));
+        if (!p)
+            throw std::bad_alloc();
+        accounting_totals&  t = totals();
+        size_t  reserved = block_size(p, bytes);
+        t.allocations.fetch_add(1, std::memory_order_relaxed);
+        t.requested.fetch_add(bytes, std::memory_order_relaxed);
+        size_t  live = t.reserved.fetch_add(reserved, std::memory_order_relaxed) + reserved;
+        size_t  peak = t.peak_reserved.load(std::memory_order_relaxed);
+        while (live > peak && !t.peak_reserved.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+        return (p);
+    }
+
+    void        deallocate(pointer p, size_type n)
+    {
+        if (!p)
+            return ;
+        accounting_totals&  t = totals();
+        t.deallocations.fetch_add(1, std::memory_order_relaxed);
+        t.requested.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+        t.reserved.fetch_sub(block_size(p, n * sizeof(T)), std::memory_order_relaxed);
+        std::free(p);
+    }
+
+    void        construct(pointer p, const T& value)
+    { ::new (static_cast<void*>(p)) T(value); }
+
+    void        destroy(pointer p)
+    { p->~T(); }
+
+    pointer     address(reference x) const
+    { return (&x); }
+
+    const_pointer   address(const_reference x) const
+    { return (&x); }
+
+    size_type   max_size() const
+    { return (std::numeric_limits<size_type>::max() / sizeof(T)); }
+};
+
+template <class T, class U>
+bool    operator==(const accounting_allocator<T>&, const accounting_allocator<U>&)
+{ return (true); }
+
+template <class T, class U>
+bool    operator!=(const accounting_allocator<T>&, const accounting_allocator<U>&)
+{ return (false); }
+
+template <class T>
+struct allocation_size<accounting_allocator<T> >
+{
+    static const bool exact = true;
+
+    static size_t   reserved(const void* p, size_t requested)
+    { return (accounting_allocator<T>::block_size(p, requested)); }
+};
+
+}
+
+#endif
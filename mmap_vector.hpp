@@ -0,0 +1,460 @@
+#ifndef MMAP_VECTOR_HPP
+# define MMAP_VECTOR_HPP
+
+# include <stdint.h>
+# include <cerrno>
+# include <cstring>
+# include <algorithm>
+# include <limits>
+# include <stdexcept>
+# include <system_error>
+# include <type_traits>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "RandomIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace ft {
+
+// A vector whose elements live in a file mapped into memory. Opening an
+// existing file maps it and nothing more; the kernel pages elements in as
+// they are touched and writes dirty pages back on its own schedule, or at
+// sync(). The size is kept in a header at the start of the file, so it
+// survives the process.
+//
+// Growing extends the file with ftruncate and the mapping with mremap,
+// which may move it: like vector, that invalidates iterators. Elements are
+// stored as their bytes, so T must be trivially copyable, and a file is
+// only readable by a build with the same sizeof(T) and byte order.
+template <class T>
+class mmap_vector
+{
+public:
+    typedef T                                           value_type;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef RandomIterator<value_type, false>           iterator;
+    typedef RandomIterator<value_type const, true>      const_iterator;
+    typedef ReverseRIterator<iterator>                  reverse_iterator;
+    typedef ReverseRIterator<const_iterator>            const_reverse_iterator;
+    typedef ptrdiff_t                                   difference_type;
+    typedef size_t                                      size_type;
+
+    // How the elements are going to be read, passed on to madvise.
+    enum access
+    {
+        normal,
+        sequential,
+        random
+    };
+private:
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector stores elements as raw bytes");
+
+    struct header
+    {
+        char        magic[4];   // "FTMV"
+        uint32_t    value_size;
+        uint64_t    size;
+    };
+
+    // Elements start here, which keeps them aligned for any T a header
+    // line can hold.
+    static const size_t data_offset = 64;
+    static_assert(alignof(T) <= data_offset, "mmap_vector element alignment too large");
+
+    int         _fd;
+    char*       _base;
+    size_t      _bytes;
+    size_type   _capacity;
+    access      _access;
+
+    mmap_vector(const mmap_vector&);
+    mmap_vector&    operator=(const mmap_vector&);
+
+    static void     fail(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), std::string("ft::mmap_vector: ") + what);
+    }
+
+    static size_t   page_size()
+    {
+        static const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+        return (page);
+    }
+
+    header*         head() const
+    { return (reinterpret_cast<header*>(_base)); }
+
+    pointer         elements() const
+    { return (reinterpret_cast<pointer>(_base + data_offset)); }
+
+    // Resizes the file to `bytes` and maps all of it.
+    void            map_file(size_t bytes)
+    {
+        if (::ftruncate(_fd, off_t(bytes)) < 0)
+            fail("ftruncate");
+        void*   p;
+        if (!_base)
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        else
+        {
+# ifdef __linux__
+            p = ::mremap(_base, _bytes, bytes, MREMAP_MAYMOVE);
+# else
+            ::munmap(_base, _bytes);
+            _base = nullptr;
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+# endif
+        }
+        if (p == MAP_FAILED)
+            fail("mmap");
+        _base = static_cast<char*>(p);
+        _bytes = bytes;
+        _capacity = (bytes - data_offset) / sizeof(T);
+        if (_access != normal)
+            advise(_access);
+    }
+
+    size_t          file_bytes(size_type n) const
+    {
+        size_t  page = page_size();
+        return ((data_offset + n * sizeof(T) + page - 1) / page * page);
+    }
+
+    void            open_file(const char* path)
+    {
+        _fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (_fd < 0)
+            fail("open");
+        struct stat st;
+        if (::fstat(_fd, &st) < 0)
+            fail("fstat");
+        if (!st.st_size)
+        {
+            map_file(file_bytes(0));
+            std::memcpy(head()->magic, "FTMV", 4);
+            head()->value_size = sizeof(T);
+            head()->size = 0;
+            return ;
+        }
+        if (size_t(st.st_size) < data_offset)
+            throw std::runtime_error("ft::mmap_vector: file too short");
+        map_file(size_t(st.st_size));
+        if (std::memcmp(head()->magic, "FTMV", 4) || head()->value_size != sizeof(T))
+            throw std::runtime_error("ft::mmap_vector: not a file of this element type");
+        if (head()->size > _capacity)
+            throw std::runtime_error("ft::mmap_vector: size beyond end of file");
+    }
+
+    void            close_file()
+    {
+        if (_base)
+            ::munmap(_base, _bytes);
+        if (_fd >= 0)
+            ::close(_fd);
+        _base = nullptr;
+        _fd = -1;
+    }
+
+    // Whether [first, last) lies in the mapping, which open_gap shifts and
+    // may move. Only pointers and our own iterators can.
+    template <class It>
+    bool            overlaps(It, It) const
+    { return (false); }
+
+    bool            overlaps(const_pointer first, const_pointer last) const
+    { return (first != last && first < elements() + size() && last > elements()); }
+
+    bool            overlaps(pointer first, pointer last) const
+    { return (overlaps(const_pointer(first), const_pointer(last))); }
+
+    bool            overlaps(const_iterator first, const_iterator last) const
+    { return (first != last && overlaps(&*first, &*first + (last - first))); }
+
+    bool            overlaps(iterator first, iterator last) const
+    { return (overlaps(const_iterator(first), const_iterator(last))); }
+
+    // A single-pass range can be read only once: append it, then rotate it
+    // into place.
+    template <class InputIterator>
+    void            insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        size_type   old = size();
+        for ( ; first != last; ++first)
+            push_back(*first);
+        std::rotate(begin() + index, begin() + old, end());
+    }
+
+    template <class ForwardIterator>
+    void            insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    {
+        if (overlaps(first, last))
+        {
+            vector<value_type>  copy(first, last);
+            insert_range(index, copy.begin(), copy.end(), std::random_access_iterator_tag());
+            return ;
+        }
+        size_type   n = std::distance(first, last);
+        std::copy(first, last, open_gap(index, n));
+    }
+
+    // Opens a gap of n elements at index and returns where it starts.
+    pointer         open_gap(size_type index, size_type n)
+    {
+        size_type   sz = size();
+        if (n > max_size() - sz)
+            throw std::length_error("ft::mmap_vector");
+        if (sz + n > _capacity)
+            reserve(std::max(sz + n, 2 * _capacity));
+        pointer     p = elements() + index;
+        std::memmove(p + n, p, (sz - index) * sizeof(T));
+        head()->size = sz + n;
+        return (p);
+    }
+public:
+    // Opens path, or creates it empty, read-write.
+    explicit mmap_vector(const char* path)
+    : _fd(-1), _base(nullptr), _bytes(0), _capacity(0), _access(normal)
+    {
+        try {
+            open_file(path);
+        } catch (...) {
+            close_file();
+            throw ;
+        }
+    }
+
+    // Unmapping leaves the data in the page cache; the kernel still writes
+    // it back, but only sync() waits for the disk.
+    ~mmap_vector()
+    { close_file(); }
+
+    iterator                begin()
+    { return (elements()); }
+    const_iterator          begin() const
+    { return (const_pointer(elements())); }
+    iterator                end()
+    { return (elements() + size()); }
+    const_iterator          end() const
+    { return (const_pointer(elements() + size())); }
+    reverse_iterator        rbegin()
+    { return (end()); }
+    const_reverse_iterator  rbegin() const
+    { return (end()); }
+    reverse_iterator        rend()
+    { return (begin()); }
+    const_reverse_iterator  rend() const
+    { return (begin()); }
+
+    size_type   size() const
+    { return (size_type(head()->size)); }
+
+    size_type   max_size() const
+    {
+        return (std::min(size_type(std::numeric_limits<off_t>::max()) - data_offset,
+                         size_type(std::numeric_limits<difference_type>::max())) / sizeof(T));
+    }
+
+    size_type   capacity() const
+    { return (_capacity); }
+
+    bool        empty() const
+    { return (!size()); }
+
+    void        reserve(size_type n)
+    {
+        if (n <= _capacity)
+            return ;
+        if (n > max_size())
+            throw std::length_error("ft::mmap_vector");
+        map_file(file_bytes(n));
+    }
+
+    // Gives the file's unused tail back to the file system.
+    void        shrink_to_fit()
+    {
+        size_t  bytes = file_bytes(size());
+        if (bytes >= _bytes)
+            return ;
+# ifdef __linux__
+        void*   p = ::mremap(_base, _bytes, bytes, 0);
+        if (p == MAP_FAILED)
+            fail("mremap");
+# else
+        ::munmap(_base + bytes, _bytes - bytes);
+# endif
+        _bytes = bytes;
+        _capacity = (bytes - data_offset) / sizeof(T);
+        if (::ftruncate(_fd, off_t(bytes)) < 0)
+            fail("ftruncate");
+    }
+
+    void        resize(size_type n, value_type val = value_type())
+    {
+        size_type   sz = size();
+        if (n > sz)
+        {
+            // open_gap may move the mapping; elements() is only valid after it.
+            pointer p = open_gap(sz, n - sz);
+            std::fill(p, p + (n - sz), val);
+        }
+        else
+            head()->size = n;
+    }
+
+    reference       operator[](size_type n)
+    { return (elements()[n]); }
+    const_reference operator[](size_type n) const
+    { return (elements()[n]); }
+
+    reference       at(size_type n)
+    {
+        if (n >= size())
+            throw std::out_of_range("mmap_vector");
+        return (elements()[n]);
+    }
+
+    const_reference at(size_type n) const
+    {
+        if (n >= size())
+            throw std::out_of_range("mmap_vector");
+        return (elements()[n]);
+    }
+
+    reference       front()
+    { return (elements()[0]); }
+    const_reference front() const
+    { return (elements()[0]); }
+    reference       back()
+    { return (elements()[size() - 1]); }
+    const_reference back() const
+    { return (elements()[size() - 1]); }
+
+    pointer         data()
+    { return (elements()); }
+    const_pointer   data() const
+    { return (elements()); }
+
+    void        assign(size_type n, const value_type& val)
+    {
+        clear();
+        resize(n, val);
+    }
+
+    template <class InputIterator>
+    void        assign(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    {
+        clear();
+        insert(end(), first, last);
+    }
+
+    // val may be one of our own elements, and growing can move the
+    // mapping; it is copied before that.
+    void        push_back(const value_type& val)
+    {
+        size_type   sz = size();
+        value_type  copy(val);
+        if (sz == _capacity)
+            reserve(std::max(sz + 1, 2 * _capacity));
+        elements()[sz] = copy;
+        head()->size = sz + 1;
+    }
+
+    void        pop_back()
+    { --head()->size; }
+
+    iterator    insert(iterator position, const value_type& val)
+    {
+        size_type   index = position - begin();
+        value_type  copy(val);
+        *open_gap(index, 1) = copy;
+        return (elements() + index);
+    }
+
+    void        insert(iterator position, size_type n, const value_type& val)
+    {
+        size_type   index = position - begin();
+        value_type  copy(val);
+        pointer     p = open_gap(index, n);
+        std::fill(p, p + n, copy);
+    }
+
+    template <class InputIterator>
+    void        insert(iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type first, InputIterator last)
+    {
+        insert_range(position - begin(), first, last,
+                     typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    iterator    erase(iterator position)
+    { return (erase(position, position + 1)); }
+
+    iterator    erase(iterator first, iterator last)
+    {
+        pointer     p = &*first;
+        size_type   n = last - first;
+        std::memmove(p, p + n, (end() - last) * sizeof(T));
+        head()->size -= n;
+        return (first);
+    }
+
+    void        swap(mmap_vector& x)
+    {
+        ft::swap(_fd, x._fd);
+        ft::swap(_base, x._base);
+        ft::swap(_bytes, x._bytes);
+        ft::swap(_capacity, x._capacity);
+        ft::swap(_access, x._access);
+    }
+
+    void        clear()
+    { head()->size = 0; }
+
+    // Tells the kernel how the mapping will be read, so that it reads ahead
+    // aggressively or not at all. The hint is kept across growth.
+    void        advise(access a)
+    {
+        int advice = a == sequential ? MADV_SEQUENTIAL : a == random ? MADV_RANDOM : MADV_NORMAL;
+        if (::madvise(_base, _bytes, advice) < 0)
+            fail("madvise");
+        _access = a;
+    }
+
+    // Writes dirty pages back to the file; with wait, returns only once
+    // they are on disk.
+    void        sync(bool wait = true)
+    {
+        if (::msync(_base, _bytes, wait ? MS_SYNC : MS_ASYNC) < 0)
+            fail("msync");
+    }
+};
+
+template <class T>
+bool    operator==(const mmap_vector<T>& a, const mmap_vector<T>& b)
+{
+    return (ft::equal(a.begin(), a.end(), b.begin(), b.end()));
+}
+
+template <class T>
+bool    operator!=(const mmap_vector<T>& a, const mmap_vector<T>& b)
+{
+    return (!(a == b));
+}
+
+template <class T>
+void    swap(mmap_vector<T>& x, mmap_vector<T>& y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -1,6 +1,12 @@
 #ifndef NODE_HPP
 # define NODE_HPP
 
+# include <stdint.h>
+# include <atomic>
+# include <cstddef>
+
+# include "stats.hpp"
+
 namespace ft {
 template <typename T>
 struct  node
@@ -11,28 +17,50 @@ struct  node
     T       data;
     bool    red;
     bool    fict;
+# ifdef FT_THREADED_TREE
+    node*   succ;
+    node*   pred;
+# endif
 
     node() : parent(nullptr), left(nullptr), right(nullptr), red(false)
     ,fict(false)
+# ifdef FT_THREADED_TREE
+    ,succ(nullptr), pred(nullptr)
+# endif
     {}
 
     node(const T& val, bool red = true, bool fict = false) : parent(nullptr), left(nullptr), right(nullptr), data(val), red(red)
     ,fict(fict)
+# ifdef FT_THREADED_TREE
+    ,succ(nullptr), pred(nullptr)
+# endif
     {}
 
     node(const node& other) : parent(other.parent), left(other.left), right(other.right), data(other.data), red(other.red)
     ,fict(other.fict)
+# ifdef FT_THREADED_TREE
+    ,succ(other.succ), pred(other.pred)
+# endif
     {}
 
+    // With FT_THREADED_TREE defined the tree keeps in-order successor and
+    // predecessor links, and a step is one load instead of a climb.
     static void    next(node*& n)
     {
         if (n->fict)
             n = n->parent;
+# ifdef FT_THREADED_TREE
+        else
+            n = n->succ;
+# else
         else if  (n->right)
         {
             n = n->right;
             while (n->left)
+            {
                 n = n->left;
+                FT_STATS_ADD(stats_of<node>::get(), climbs, 1);
+            }
         }
         else if (n->parent)
         { 
@@ -42,18 +70,27 @@ struct  node
             {
                 tmp = n;
                 n = n->parent;
+                FT_STATS_ADD(stats_of<node>::get(), climbs, 1);
             }
         }
+# endif
     }
     static void    prev(node*& n)
     {
         if (n->fict)
             n = n->parent;
+# ifdef FT_THREADED_TREE
+        else
+            n = n->pred;
+# else
         else if (n->left) 
         {
 		    n = n->left;
 		    while (n->right)
+		    {
 			    n = n->right;
+			    FT_STATS_ADD(stats_of<node>::get(), climbs, 1);
+		    }
 	    }
 	    else if (n->parent)
 	    {
@@ -63,8 +100,10 @@ struct  node
             {
                 tmp = n;
                 n = n->parent;
+                FT_STATS_ADD(stats_of<node>::get(), climbs, 1);
             }
         }
+# endif
     }
 
     bool	operator==(const node& other) 
@@ -83,6 +122,64 @@ struct  node
 
 };
 
+// Immutable node shared between versions of a persistent_map.
+// Children are never modified once built; a node owns one reference
+// to each of its children and is freed when its own count drops to zero.
+template <typename T>
+struct  persistent_node
+{
+    const persistent_node*      left;
+    const persistent_node*      right;
+    T                           data;
+    bool                        red;
+    mutable std::atomic<size_t> refs;
+
+    persistent_node(const T& val, bool red, const persistent_node* left, const persistent_node* right)
+    : left(left), right(right), data(val), red(red), refs(1)
+    {
+        if (left)
+            left->retain();
+        if (right)
+            right->retain();
+    }
+
+    void    retain() const
+    { refs.fetch_add(1, std::memory_order_relaxed); }
+
+    bool    release() const
+    { return (refs.fetch_sub(1, std::memory_order_acq_rel) == 1); }
+
+private:
+    persistent_node(const persistent_node&);
+    persistent_node&    operator=(const persistent_node&);
+};
+
+// Node of an offset_map. Links are byte offsets from the start of the
+// arena the tree lives in, so the arena can be mapped at any address;
+// offset 0 is the arena header, which no node occupies, and stands for nil.
+template <typename T>
+struct  offset_node
+{
+    uint64_t    parent;
+    uint64_t    left;
+    uint64_t    right;
+    uint64_t    red;
+    T           data;
+};
+
+// Start of an offset_map arena.
+struct  offset_arena_header
+{
+    char        magic[8];
+    uint32_t    key_size;
+    uint32_t    mapped_size;
+    uint64_t    node_size;
+    uint64_t    root;
+    uint64_t    size;
+    uint64_t    used;       // bytes handed out so far, header included
+    uint64_t    free_list;  // erased nodes, chained through left
+};
+
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,708 @@
+#ifndef OFFSET_MAP_HPP
+# define OFFSET_MAP_HPP
+
+# include <stdint.h>
+# include <cerrno>
+# include <cstring>
+# include <algorithm>
+# include <functional>
+# include <limits>
+# include <new>
+# include <stdexcept>
+# include <string>
+# include <system_error>
+# include <type_traits>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "OffsetIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "node.hpp"
+
+namespace ft {
+
+// A map that lives in a file. Its red-black tree is built from
+// offset_node, whose links are offsets into one arena, and the arena is
+// the file mapped into memory. Opening an existing file maps it and checks
+// its header, nothing more, so a process can start looking keys up at
+// once; pages come in as lookups touch them.
+//
+// Keys and values are stored as their bytes and must be trivially
+// copyable; the file is only readable by a build with the same sizes and
+// byte order. Erased nodes are kept on a free list for reuse, and the file
+// grows by doubling. A file opened read_only is mapped PROT_READ and is
+// read through a const reference: the mutators, and the non-const
+// accessors that would hand out writable references into it, throw
+// std::logic_error. Updates reach the disk when the kernel writes them
+// back or at sync(); a crash in the middle of an update can leave the
+// tree inconsistent.
+template < class Key, class T, class Compare = std::less<Key> >
+class offset_map
+{
+public:
+    typedef Key                                         key_type;
+    typedef T                                           mapped_type;
+    typedef pair<const Key, T>                          value_type;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+    typedef Compare                                     key_compare;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef value_type*                                 pointer;
+    typedef const value_type*                           const_pointer;
+    typedef OffsetIterator<value_type, false>           iterator;
+    typedef OffsetIterator<value_type, true>            const_iterator;
+    typedef ReverseBIterator<iterator>                  reverse_iterator;
+    typedef ReverseBIterator<const_iterator>            const_reverse_iterator;
+
+    enum open_mode
+    {
+        read_write,
+        read_only
+    };
+private:
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<T>::value,
+                  "offset_map stores keys and values as raw bytes");
+
+    typedef offset_node<value_type>     node_type;
+    typedef offset_arena_header         header;
+
+    // The first node starts on a cache line of its own.
+    static const uint64_t   first_node = (sizeof(header) + 63) / 64 * 64;
+
+    int         _fd;
+    // The mapping's address lives in a heap cell of its own. Iterators
+    // point at the cell, so they follow a remap, and after swap they keep
+    // reading the arena they came from.
+    char**      _arena;
+    size_t      _bytes;
+    bool        _writable;
+    key_compare _comp;
+
+    offset_map(const offset_map&);
+    offset_map& operator=(const offset_map&);
+
+    static void     fail(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), std::string("ft::offset_map: ") + what);
+    }
+
+    static size_t   page_size()
+    {
+        static const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+        return (page);
+    }
+
+    static size_t   round_to_page(size_t bytes)
+    {
+        return ((bytes + page_size() - 1) / page_size() * page_size());
+    }
+
+    char*&          base() const
+    { return (*_arena); }
+
+    header*         head() const
+    { return (reinterpret_cast<header*>(base())); }
+
+    node_type*      node_at(uint64_t off) const
+    { return (reinterpret_cast<node_type*>(base() + off)); }
+
+    const key_type& key(uint64_t off) const
+    { return (node_at(off)->data.first); }
+
+    bool            is_red(uint64_t off) const
+    { return (off && node_at(off)->red); }
+
+    void            require_writable() const
+    {
+        if (!_writable)
+            throw std::logic_error("ft::offset_map: opened read-only");
+    }
+
+    // Maps the first `bytes` of the file, growing it first when writable.
+    void            map_file(size_t bytes)
+    {
+        void*   p;
+        if (!_writable)
+            p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, _fd, 0);
+        else
+        {
+            if (::ftruncate(_fd, off_t(bytes)) < 0)
+                fail("ftruncate");
+            if (!base())
+                p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            else
+            {
+# ifdef __linux__
+                p = ::mremap(base(), _bytes, bytes, MREMAP_MAYMOVE);
+# else
+                ::munmap(base(), _bytes);
+                base() = nullptr;
+                p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+# endif
+            }
+        }
+        if (p == MAP_FAILED)
+            fail("mmap");
+        base() = static_cast<char*>(p);
+        _bytes = bytes;
+    }
+
+    void            open_file(const char* path)
+    {
+        _fd = ::open(path, _writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+        if (_fd < 0)
+            fail("open");
+        struct stat st;
+        if (::fstat(_fd, &st) < 0)
+            fail("fstat");
+        if (!st.st_size && _writable)
+        {
+            map_file(round_to_page(first_node + sizeof(node_type)));
+            std::memcpy(head()->magic, "FTOMAP1", 8);
+            head()->key_size = sizeof(key_type);
+            head()->mapped_size = sizeof(mapped_type);
+            head()->node_size = sizeof(node_type);
+            head()->root = 0;
+            head()->size = 0;
+            head()->used = first_node;
+            head()->free_list = 0;
+            return ;
+        }
+        if (size_t(st.st_size) < sizeof(header))
+            throw std::runtime_error("ft::offset_map: file too short");
+        map_file(size_t(st.st_size));
+        if (std::memcmp(head()->magic, "FTOMAP1", 8) || head()->key_size != sizeof(key_type)
+            || head()->mapped_size != sizeof(mapped_type) || head()->node_size != sizeof(node_type))
+            throw std::runtime_error("ft::offset_map: not a file of this key and value type");
+        if (head()->used > _bytes)
+            throw std::runtime_error("ft::offset_map: arena beyond end of file");
+    }
+
+    void            close_file()
+    {
+        if (base())
+            ::munmap(base(), _bytes);
+        if (_fd >= 0)
+            ::close(_fd);
+        base() = nullptr;
+        _fd = -1;
+    }
+
+    // May grow and move the arena: offsets stay valid, pointers do not.
+    uint64_t        allocate_node()
+    {
+        uint64_t    off = head()->free_list;
+        if (off)
+        {
+            head()->free_list = node_at(off)->left;
+            return (off);
+        }
+        off = head()->used;
+        if (off + sizeof(node_type) > _bytes)
+            map_file(round_to_page(std::max(2 * _bytes, size_t(off + sizeof(node_type)))));
+        head()->used = off + sizeof(node_type);
+        return (off);
+    }
+
+    void            free_node(uint64_t off)
+    {
+        node_at(off)->left = head()->free_list;
+        head()->free_list = off;
+    }
+
+    void            rotate_left(uint64_t x)
+    {
+        node_type*  nx = node_at(x);
+        uint64_t    y = nx->right;
+        node_type*  ny = node_at(y);
+        nx->right = ny->left;
+        if (ny->left)
+            node_at(ny->left)->parent = x;
+        ny->parent = nx->parent;
+        if (!nx->parent)
+            head()->root = y;
+        else if (node_at(nx->parent)->left == x)
+            node_at(nx->parent)->left = y;
+        else
+            node_at(nx->parent)->right = y;
+        ny->left = x;
+        nx->parent = y;
+    }
+
+    void            rotate_right(uint64_t x)
+    {
+        node_type*  nx = node_at(x);
+        uint64_t    y = nx->left;
+        node_type*  ny = node_at(y);
+        nx->left = ny->right;
+        if (ny->right)
+            node_at(ny->right)->parent = x;
+        ny->parent = nx->parent;
+        if (!nx->parent)
+            head()->root = y;
+        else if (node_at(nx->parent)->right == x)
+            node_at(nx->parent)->right = y;
+        else
+            node_at(nx->parent)->left = y;
+        ny->right = x;
+        nx->parent = y;
+    }
+
+    void            insert_fixup(uint64_t z)
+    {
+        while (is_red(node_at(z)->parent))
+        {
+            uint64_t    p = node_at(z)->parent;
+            uint64_t    g = node_at(p)->parent;
+            if (p == node_at(g)->left)
+            {
+                uint64_t    u = node_at(g)->right;
+                if (is_red(u))
+                {
+                    node_at(p)->red = 0;
+                    node_at(u)->red = 0;
+                    node_at(g)->red = 1;
+                    z = g;
+                    continue ;
+                }
+                if (z == node_at(p)->right)
+                {
+                    z = p;
+                    rotate_left(z);
+                    p = node_at(z)->parent;
+                }
+                node_at(p)->red = 0;
+                node_at(g)->red = 1;
+                rotate_right(g);
+            }
+            else
+            {
+                uint64_t    u = node_at(g)->left;
+                if (is_red(u))
+                {
+                    node_at(p)->red = 0;
+                    node_at(u)->red = 0;
+                    node_at(g)->red = 1;
+                    z = g;
+                    continue ;
+                }
+                if (z == node_at(p)->left)
+                {
+                    z = p;
+                    rotate_right(z);
+                    p = node_at(z)->parent;
+                }
+                node_at(p)->red = 0;
+                node_at(g)->red = 1;
+                rotate_left(g);
+            }
+        }
+        node_at(head()->root)->red = 0;
+    }
+
+    void            replace_child(uint64_t parent, uint64_t old_child, uint64_t new_child)
+    {
+        if (!parent)
+            head()->root = new_child;
+        else if (node_at(parent)->left == old_child)
+            node_at(parent)->left = new_child;
+        else
+            node_at(parent)->right = new_child;
+    }
+
+    // Unlinks z and restores the colouring. Nil has no node to hang a
+    // parent on, so the parent of x is tracked alongside it.
+    void            erase_node(uint64_t z)
+    {
+        node_type*  nz = node_at(z);
+        uint64_t    y = z;
+        uint64_t    x;
+        uint64_t    x_parent;
+        if (!nz->left)
+            x = nz->right;
+        else if (!nz->right)
+            x = nz->left;
+        else
+        {
+            for (y = nz->right; node_at(y)->left; )
+                y = node_at(y)->left;
+            x = node_at(y)->right;
+        }
+        bool    removed_red;
+        if (y != z)
+        {
+            node_type*  ny = node_at(y);
+            node_at(nz->left)->parent = y;
+            ny->left = nz->left;
+            if (y != nz->right)
+            {
+                x_parent = ny->parent;
+                if (x)
+                    node_at(x)->parent = x_parent;
+                node_at(x_parent)->left = x;
+                ny->right = nz->right;
+                node_at(nz->right)->parent = y;
+            }
+            else
+                x_parent = y;
+            replace_child(nz->parent, z, y);
+            ny->parent = nz->parent;
+            removed_red = ny->red;
+            ny->red = nz->red;
+        }
+        else
+        {
+            x_parent = nz->parent;
+            if (x)
+                node_at(x)->parent = x_parent;
+            replace_child(nz->parent, z, x);
+            removed_red = nz->red;
+        }
+        if (!removed_red)
+        {
+            while (x != head()->root && !is_red(x))
+            {
+                if (x == node_at(x_parent)->left)
+                {
+                    uint64_t    w = node_at(x_parent)->right;
+                    if (is_red(w))
+                    {
+                        node_at(w)->red = 0;
+                        node_at(x_parent)->red = 1;
+                        rotate_left(x_parent);
+                        w = node_at(x_parent)->right;
+                    }
+                    if (!is_red(node_at(w)->left) && !is_red(node_at(w)->right))
+                    {
+                        node_at(w)->red = 1;
+                        x = x_parent;
+                        x_parent = node_at(x)->parent;
+                        continue ;
+                    }
+                    if (!is_red(node_at(w)->right))
+                    {
+                        node_at(node_at(w)->left)->red = 0;
+                        node_at(w)->red = 1;
+                        rotate_right(w);
+                        w = node_at(x_parent)->right;
+                    }
+                    node_at(w)->red = node_at(x_parent)->red;
+                    node_at(x_parent)->red = 0;
+                    node_at(node_at(w)->right)->red = 0;
+                    rotate_left(x_parent);
+                }
+                else
+                {
+                    uint64_t    w = node_at(x_parent)->left;
+                    if (is_red(w))
+                    {
+                        node_at(w)->red = 0;
+                        node_at(x_parent)->red = 1;
+                        rotate_right(x_parent);
+                        w = node_at(x_parent)->left;
+                    }
+                    if (!is_red(node_at(w)->left) && !is_red(node_at(w)->right))
+                    {
+                        node_at(w)->red = 1;
+                        x = x_parent;
+                        x_parent = node_at(x)->parent;
+                        continue ;
+                    }
+                    if (!is_red(node_at(w)->left))
+                    {
+                        node_at(node_at(w)->right)->red = 0;
+                        node_at(w)->red = 1;
+                        rotate_left(w);
+                        w = node_at(x_parent)->left;
+                    }
+                    node_at(w)->red = node_at(x_parent)->red;
+                    node_at(x_parent)->red = 0;
+                    node_at(node_at(w)->left)->red = 0;
+                    rotate_right(x_parent);
+                }
+                break ;
+            }
+            if (x)
+                node_at(x)->red = 0;
+        }
+        --head()->size;
+        free_node(z);
+    }
+
+    uint64_t        lower_bound_off(const key_type& k) const
+    {
+        uint64_t    n = head()->root;
+        uint64_t    res = 0;
+        while (n)
+        {
+            if (!_comp(key(n), k))
+            {
+                res = n;
+                n = node_at(n)->left;
+            }
+            else
+                n = node_at(n)->right;
+        }
+        return (res);
+    }
+
+    uint64_t        upper_bound_off(const key_type& k) const
+    {
+        uint64_t    n = head()->root;
+        uint64_t    res = 0;
+        while (n)
+        {
+            if (_comp(k, key(n)))
+            {
+                res = n;
+                n = node_at(n)->left;
+            }
+            else
+                n = node_at(n)->right;
+        }
+        return (res);
+    }
+
+    uint64_t        find_off(const key_type& k) const
+    {
+        uint64_t    n = lower_bound_off(k);
+        if (n && _comp(k, key(n)))
+            return (0);
+        return (n);
+    }
+
+    uint64_t        first_off() const
+    {
+        uint64_t    n = head()->root;
+        while (n && node_at(n)->left)
+            n = node_at(n)->left;
+        return (n);
+    }
+
+    // Every iterator and reference that allows writes is made here, so a
+    // read-only map refuses them in one place.
+    iterator        make_iterator(uint64_t off)
+    {
+        require_writable();
+        return (iterator(_arena, off));
+    }
+
+    const_iterator  make_iterator(uint64_t off) const
+    { return (const_iterator(_arena, off)); }
+public:
+    // Opens path, or creates an empty map there when opened read_write.
+    explicit offset_map(const char* path, open_mode mode = read_write, const Compare& comp = Compare())
+    : _fd(-1), _arena(new char*(nullptr)), _bytes(0), _writable(mode == read_write), _comp(comp)
+    {
+        try {
+            open_file(path);
+        } catch (...) {
+            close_file();
+            delete _arena;
+            throw ;
+        }
+    }
+
+    ~offset_map()
+    {
+        close_file();
+        delete _arena;
+    }
+
+    iterator                begin (void)
+    { return (make_iterator(first_off())); }
+    const_iterator          begin (void) const
+    { return (make_iterator(first_off())); }
+    iterator                end (void)
+    { return (make_iterator(0)); }
+    const_iterator          end (void) const
+    { return (make_iterator(0)); }
+    reverse_iterator        rbegin (void)
+    { return (end()); }
+    const_reverse_iterator  rbegin (void) const
+    { return (end()); }
+    reverse_iterator        rend (void)
+    { return (begin()); }
+    const_reverse_iterator  rend (void) const
+    { return (begin()); }
+
+    bool        empty() const { return (!head()->size); }
+    size_type   size() const { return (size_type(head()->size)); }
+    size_type   max_size() const
+    { return ((size_type(std::numeric_limits<off_t>::max()) - first_node) / sizeof(node_type)); }
+
+    // Grows the file so that n elements fit without another remap.
+    void        reserve(size_type n)
+    {
+        require_writable();
+        size_t  bytes = first_node + n * sizeof(node_type);
+        if (bytes > _bytes)
+            map_file(round_to_page(bytes));
+    }
+
+    pair<iterator, bool>    insert(const value_type& value)
+    {
+        require_writable();
+        value_type  v(value);
+        uint64_t    parent = 0;
+        uint64_t    n = head()->root;
+        bool        left = true;
+        while (n)
+        {
+            parent = n;
+            if (_comp(v.first, key(n)))
+            {
+                left = true;
+                n = node_at(n)->left;
+            }
+            else if (_comp(key(n), v.first))
+            {
+                left = false;
+                n = node_at(n)->right;
+            }
+            else
+                return (ft::make_pair(make_iterator(n), false));
+        }
+        uint64_t    z = allocate_node();
+        node_type*  nz = node_at(z);
+        ::new (static_cast<void*>(&nz->data)) value_type(v);
+        nz->parent = parent;
+        nz->left = 0;
+        nz->right = 0;
+        nz->red = 1;
+        if (!parent)
+            head()->root = z;
+        else if (left)
+            node_at(parent)->left = z;
+        else
+            node_at(parent)->right = z;
+        ++head()->size;
+        insert_fixup(z);
+        return (ft::make_pair(make_iterator(z), true));
+    }
+
+    iterator    insert(iterator hint, const value_type& value)
+    {
+        (void)hint;
+        return (insert(value).first);
+    }
+
+    template< class InputIterator >
+    void        insert( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last )
+    {
+        for ( ; first != last; ++first)
+            insert(*first);
+    }
+
+    T&          operator[](const Key& key)
+    { return (insert(ft::make_pair(key, mapped_type())).first->second); }
+
+    T&          at(const Key& key)
+    {
+        require_writable();
+        uint64_t    n = find_off(key);
+        if (!n)
+            throw std::out_of_range("offset_map::at:  key not found");
+        return (node_at(n)->data.second);
+    }
+
+    const T&    at(const Key& key) const
+    {
+        uint64_t    n = find_off(key);
+        if (!n)
+            throw std::out_of_range("offset_map::at:  key not found");
+        return (node_at(n)->data.second);
+    }
+
+    void        erase(iterator pos)
+    {
+        require_writable();
+        erase_node(pos._off);
+    }
+
+    void        erase(iterator first, iterator last)
+    {
+        while (first != last)
+            erase(first++);
+    }
+
+    size_type   erase(const Key& key)
+    {
+        require_writable();
+        uint64_t    n = find_off(key);
+        if (!n)
+            return (0);
+        erase_node(n);
+        return (1);
+    }
+
+    // Empties the tree; the file keeps its size for the next inserts.
+    void        clear()
+    {
+        require_writable();
+        head()->root = 0;
+        head()->size = 0;
+        head()->used = first_node;
+        head()->free_list = 0;
+    }
+
+    // Iterators stay valid and move with their elements, as for map.
+    void        swap(offset_map& other)
+    {
+        ft::swap(_fd, other._fd);
+        ft::swap(_arena, other._arena);
+        ft::swap(_bytes, other._bytes);
+        ft::swap(_writable, other._writable);
+        ft::swap(_comp, other._comp);
+    }
+
+    size_type       count(const Key& key) const
+    { return (find_off(key) ? 1 : 0); }
+
+    iterator        find(const Key& key)
+    { return (make_iterator(find_off(key))); }
+    const_iterator  find(const Key& key) const
+    { return (make_iterator(find_off(key))); }
+
+    iterator        lower_bound(const Key& key)
+    { return (make_iterator(lower_bound_off(key))); }
+    const_iterator  lower_bound(const Key& key) const
+    { return (make_iterator(lower_bound_off(key))); }
+
+    iterator        upper_bound(const Key& key)
+    { return (make_iterator(upper_bound_off(key))); }
+    const_iterator  upper_bound(const Key& key) const
+    { return (make_iterator(upper_bound_off(key))); }
+
+    pair<iterator,iterator>             equal_range(const Key& key)
+    { return (ft::make_pair(lower_bound(key), upper_bound(key))); }
+    pair<const_iterator,const_iterator> equal_range(const Key& key) const
+    { return (ft::make_pair(lower_bound(key), upper_bound(key))); }
+
+    key_compare key_comp() const
+    { return (_comp); }
+
+    // Writes dirty pages back to the file; with wait, returns only once
+    // they are on disk.
+    void        sync(bool wait = true)
+    {
+        if (_writable && ::msync(base(), _bytes, wait ? MS_SYNC : MS_ASYNC) < 0)
+            fail("msync");
+    }
+};
+
+template < class Key, class T, class Compare >
+void    swap(offset_map<Key, T, Compare>& x, offset_map<Key, T, Compare>& y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
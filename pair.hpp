@@ -12,7 +12,7 @@ struct pair
     Key     first;
     T       second;
 
-    pair() : first(0)
+    pair() : first(), second()
     {}
 
     pair( const Key& x, const T& y) : first(x), second(y)
@@ -0,0 +1,265 @@
+#ifndef PARALLEL_HPP
+# define PARALLEL_HPP
+
+# include <atomic>
+# include <iterator>
+
+# include "thread_pool.hpp"
+# include "vector.hpp"
+
+namespace ft {
+
+// Ranges per worker: the tree is cut into more pieces than there are
+// threads so that stealing can even out uneven subtrees.
+enum { parallel_split_factor = 4 };
+
+// Iterator ranges shorter than two grains run on the calling thread; longer
+// ones are cut into chunks of at least one grain each.
+enum { parallel_grain = 16384 };
+
+template <class Container, class Iterator>
+ft::vector<Iterator>    parallel_cuts(Container& c, thread_pool& pool)
+{
+    ft::vector<Iterator>    cuts;
+    c.split(pool.size() * parallel_split_factor, std::back_inserter(cuts));
+    return (cuts);
+}
+
+// Calls f on every element of a tree container (map, multimap, set,
+// multiset). Each task walks one range in order; ranges run concurrently,
+// so f must be safe to call from several threads at once.
+template <class Container, class Function>
+void    parallel_for_each(Container& c, Function f, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename Container::iterator    iterator;
+
+    ft::vector<iterator>    cuts = parallel_cuts<Container, iterator>(c, pool);
+    task_group              group(pool);
+    for (size_t i = 0; i + 1 < cuts.size(); ++i)
+    {
+        iterator    first = cuts[i];
+        iterator    last = cuts[i + 1];
+        group.run([first, last, f] {
+            Function    fn(f);
+            for (iterator it = first; it != last; ++it)
+                fn(*it);
+        });
+    }
+    group.wait();
+}
+
+// Folds every range with op(acc, element) starting from identity, then
+// combines the partial results left to right with combine(left, right).
+// The result matches a sequential in-order fold whenever op and combine
+// agree and combine is associative; it need not be commutative.
+template <class Container, class T, class Op, class Combine>
+T       parallel_reduce(const Container& c, T identity, Op op, Combine combine, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename Container::const_iterator  iterator;
+
+    struct  slot { T value; };
+
+    ft::vector<iterator>    cuts = parallel_cuts<const Container, iterator>(c, pool);
+    slot                    init = { identity };
+    ft::vector<slot>        partial(cuts.size(), init);
+    task_group              group(pool);
+    for (size_t i = 0; i + 1 < cuts.size(); ++i)
+    {
+        iterator    first = cuts[i];
+        iterator    last = cuts[i + 1];
+        T*          out = &partial[i].value;
+        group.run([first, last, out, op]() {
+            T   acc = *out;
+            for (iterator it = first; it != last; ++it)
+                acc = op(acc, *it);
+            *out = acc;
+        });
+    }
+    group.wait();
+    T   result = identity;
+    for (size_t i = 0; i + 1 < cuts.size(); ++i)
+        result = combine(result, partial[i].value);
+    return (result);
+}
+
+// Single-operation form: op folds elements and combines partial results.
+template <class Container, class T, class Op>
+T       parallel_reduce(const Container& c, T identity, Op op, thread_pool& pool = thread_pool::instance())
+{
+    return (parallel_reduce(c, identity, op, op, pool));
+}
+
+// Enables the iterator-range overloads below for random-access iterators
+// only, so that they never compete with the container forms above.
+template <class Category, class R>
+struct if_random_access
+{};
+
+template <class R>
+struct if_random_access<std::random_access_iterator_tag, R>
+{
+    typedef R type;
+};
+
+template <class Size>
+Size    parallel_chunk_count(Size n, const thread_pool& pool)
+{
+    Size    chunks = n / parallel_grain;
+    Size    limit = pool.size() * parallel_split_factor;
+    return (chunks > limit ? limit : chunks);
+}
+
+// Calls body(i, lo, hi) for every chunk i of [0, n), concurrently when
+// there is more than one chunk.
+template <class Size, class Body>
+void    parallel_chunks(Size n, Size chunks, const Body& body, thread_pool& pool)
+{
+    if (chunks < 2)
+    {
+        if (n)
+            body(Size(0), Size(0), n);
+        return ;
+    }
+    task_group  group(pool);
+    for (Size i = 0; i < chunks; ++i)
+    {
+        Size    lo = n * i / chunks;
+        Size    hi = n * (i + 1) / chunks;
+        group.run([&body, i, lo, hi] { body(i, lo, hi); });
+    }
+    group.wait();
+}
+
+template <class RandomIt, class Function>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, void>::type
+        parallel_for_each(RandomIt first, RandomIt last, Function f, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type n = last - first;
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, f](difference_type, difference_type lo, difference_type hi) {
+        Function    fn(f);
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it)
+            fn(*it);
+    }, pool);
+}
+
+template <class RandomIt, class OutputIt, class UnaryOp>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, OutputIt>::type
+        parallel_transform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type n = last - first;
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, d_first, op](difference_type, difference_type lo, difference_type hi) {
+        OutputIt    out = d_first + lo;
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it, ++out)
+            *out = op(*it);
+    }, pool);
+    return (d_first + n);
+}
+
+// Folds each chunk with op starting from identity and combines the chunk
+// results left to right with op, so op must be associative but need not
+// be commutative.
+template <class RandomIt, class T, class Op>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, T>::type
+        parallel_reduce(RandomIt first, RandomIt last, T identity, Op op, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    struct  slot { T value; };
+
+    difference_type     n = last - first;
+    difference_type     chunks = parallel_chunk_count(n, pool);
+    slot                init = { identity };
+    ft::vector<slot>    partial(chunks ? chunks : 1, init);
+    slot*               out = &partial[0];
+    parallel_chunks(n, chunks, [first, out, op](difference_type i, difference_type lo, difference_type hi) {
+        T   acc = out[i].value;
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it)
+            acc = op(acc, *it);
+        out[i].value = acc;
+    }, pool);
+    T   result = partial[0].value;
+    for (size_t i = 1; i < partial.size(); ++i)
+        result = op(result, partial[i].value);
+    return (result);
+}
+
+template <class RandomIt, class T>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, void>::type
+        parallel_fill(RandomIt first, RandomIt last, const T& value, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type n = last - first;
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, &value](difference_type, difference_type lo, difference_type hi) {
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it)
+            *it = value;
+    }, pool);
+}
+
+template <class RandomIt, class OutputIt>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, OutputIt>::type
+        parallel_copy(RandomIt first, RandomIt last, OutputIt d_first, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type n = last - first;
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, d_first](difference_type, difference_type lo, difference_type hi) {
+        OutputIt    out = d_first + lo;
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it, ++out)
+            *out = *it;
+    }, pool);
+    return (d_first + n);
+}
+
+// Returns the first match, as the sequential search would. Chunks stop
+// scanning once a match has been found before their current position.
+template <class RandomIt, class Predicate>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category, RandomIt>::type
+        parallel_find_if(RandomIt first, RandomIt last, Predicate pred, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type                 n = last - first;
+    std::atomic<difference_type>    found(n);
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, pred, &found](difference_type, difference_type lo, difference_type hi) {
+        Predicate   p(pred);
+        for (difference_type i = lo; i < hi && i < found.load(std::memory_order_relaxed); ++i)
+        {
+            if (!p(first[i]))
+                continue ;
+            difference_type best = found.load(std::memory_order_relaxed);
+            while (i < best && !found.compare_exchange_weak(best, i, std::memory_order_relaxed))
+                ;
+            return ;
+        }
+    }, pool);
+    return (first + found.load());
+}
+
+template <class RandomIt, class Predicate>
+typename if_random_access<typename std::iterator_traits<RandomIt>::iterator_category,
+                          typename std::iterator_traits<RandomIt>::difference_type>::type
+        parallel_count_if(RandomIt first, RandomIt last, Predicate pred, thread_pool& pool = thread_pool::instance())
+{
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    difference_type                 n = last - first;
+    std::atomic<difference_type>    count(0);
+    parallel_chunks(n, parallel_chunk_count(n, pool), [first, pred, &count](difference_type, difference_type lo, difference_type hi) {
+        Predicate       p(pred);
+        difference_type local = 0;
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it)
+            if (p(*it))
+                ++local;
+        count.fetch_add(local, std::memory_order_relaxed);
+    }, pool);
+    return (count.load());
+}
+
+}
+
+#endif
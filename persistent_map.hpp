@@ -0,0 +1,464 @@
+#ifndef PERSISTENT_MAP_HPP
+# define PERSISTENT_MAP_HPP
+
+# include <memory>
+# include <functional>
+# include <stdexcept>
+
+# include "PersistentIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "node.hpp"
+
+namespace ft{
+
+// Red-black map with path copying: every update rebuilds only the nodes
+// on the way from the root to the change and shares everything else with
+// the previous version. Copies and snapshot() are O(1) and stay valid for
+// as long as they are alive, whatever happens to the map they came from.
+//
+// Insertion follows Okasaki, deletion follows Kahrs ("Red-black trees with
+// types", JFP 2001). Subtrees may outlive the map that built them, so nodes
+// are released through a default-constructed allocator.
+template< class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<pair<const Key, T> > >
+class persistent_map
+{
+public:
+    typedef Key                                                             key_type;
+    typedef T                                                               mapped_type;
+    typedef pair<const Key, T>                                              value_type;
+    typedef size_t                                                          size_type;
+    typedef ptrdiff_t                                                       difference_type;
+    typedef Compare                                                         key_compare;
+    typedef Allocator                                                       allocator_type;
+    typedef const value_type&                                               reference;
+    typedef const value_type&                                               const_reference;
+    typedef const value_type*                                               pointer;
+    typedef const value_type*                                               const_pointer;
+    typedef PersistentIterator<value_type>                                  iterator;
+    typedef PersistentIterator<value_type>                                  const_iterator;
+    typedef ReverseBIterator<iterator>                                      reverse_iterator;
+    typedef ReverseBIterator<const_iterator>                                const_reverse_iterator;
+    typedef persistent_node<value_type>                                     node_type;
+private:
+    typedef typename Allocator::template rebind<node_type>::other          node_allocator;
+    typedef const node_type*                                                link;
+
+    // Owning handle: keeps one reference to a node for as long as it lives.
+    class node_ptr
+    {
+        link    _n;
+    public:
+        node_ptr(link n = nullptr) : _n(n)
+        {
+            if (_n)
+                _n->retain();
+        }
+
+        node_ptr(const node_ptr& other) : _n(other._n)
+        {
+            if (_n)
+                _n->retain();
+        }
+
+        ~node_ptr()
+        { persistent_map::release(_n); }
+
+        node_ptr&   operator = (const node_ptr& other)
+        {
+            if (other._n)
+                other._n->retain();
+            persistent_map::release(_n);
+            _n = other._n;
+            return (*this);
+        }
+
+        static node_ptr adopt(link n)
+        {
+            node_ptr    p;
+            p._n = n;
+            return (p);
+        }
+
+        link    get(void) const
+        { return (_n); }
+
+        link    operator -> (void) const
+        { return (_n); }
+    };
+
+    node_ptr        _root;
+    key_compare     _comp;
+    size_type       _sz;
+public:
+    explicit persistent_map( const Compare& comp = Compare()) : _root(), _comp(comp), _sz(0)
+    {}
+
+    template< class InputIterator >
+    persistent_map( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last, const Compare& comp = Compare())
+    : _root(), _comp(comp), _sz(0)
+    { insert(first, last); }
+
+    persistent_map( const persistent_map& other ) : _root(other._root), _comp(other._comp), _sz(other._sz)
+    {}
+
+    persistent_map& operator= (const persistent_map& x)
+    {
+        _root = x._root;
+        _comp = x._comp;
+        _sz = x._sz;
+        return (*this);
+    }
+
+    ~persistent_map()
+    {}
+
+    persistent_map  snapshot() const
+    { return (*this); }
+
+    void clear()
+    {
+        _root = node_ptr();
+        _sz = 0;
+    }
+
+    pair<iterator, bool> insert( const value_type& value )
+    {
+        iterator    it(_root.get());
+        bool        found = false;
+        node_ptr    root = ins(_root.get(), value, false, found, it);
+        if (found)
+            return (ft::make_pair(it, false));
+        _root = blacken(root);
+        ++_sz;
+        return (ft::make_pair(find(value.first), true));
+    }
+
+    template< class InputIterator >
+    void insert( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last )
+    {
+        for( ; first != last; ++first)
+            insert(*first);
+    }
+
+    pair<iterator, bool> insert_or_assign( const Key& key, const T& obj )
+    {
+        iterator    it(_root.get());
+        bool        found = false;
+        _root = blacken(ins(_root.get(), value_type(key, obj), true, found, it));
+        if (!found)
+            ++_sz;
+        return (ft::make_pair(find(key), !found));
+    }
+
+    size_type erase( const key_type& key )
+    {
+        if (find(key) == end())
+            return (0);
+        _root = blacken(del(_root.get(), key));
+        --_sz;
+        return (1);
+    }
+
+    void erase( iterator pos )
+    { erase(pos->first); }
+
+    iterator find( const Key& key ) const
+    {
+        iterator    it(_root.get());
+        for (link n = _root.get(); n; )
+        {
+            it.push(n);
+            if (_comp(key, n->data.first))
+                n = n->left;
+            else if (_comp(n->data.first, key))
+                n = n->right;
+            else
+                return (it);
+        }
+        return (end());
+    }
+
+    size_type   count( const Key& key ) const
+    { return (find(key) != end()); }
+
+    const T&    at( const Key& key ) const
+    {
+        iterator    it = find(key);
+        if (it == end())
+            throw std::out_of_range("persistent_map::at:  key not found");
+        return (it->second);
+    }
+
+    iterator lower_bound( const Key& key ) const
+    {
+        iterator    it(_root.get());
+        int         found = 0;
+        for (link n = _root.get(); n; )
+        {
+            it.push(n);
+            if (_comp(n->data.first, key))
+                n = n->right;
+            else
+            {
+                found = it.depth();
+                n = n->left;
+            }
+        }
+        it.truncate(found);
+        return (it);
+    }
+
+    iterator upper_bound( const Key& key ) const
+    {
+        iterator    it(_root.get());
+        int         found = 0;
+        for (link n = _root.get(); n; )
+        {
+            it.push(n);
+            if (_comp(key, n->data.first))
+            {
+                found = it.depth();
+                n = n->left;
+            }
+            else
+                n = n->right;
+        }
+        it.truncate(found);
+        return (it);
+    }
+
+    pair<iterator,iterator> equal_range( const Key& key ) const
+    { return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+    key_compare key_comp() const
+    { return (_comp); }
+
+    allocator_type  get_allocator() const
+    { return (allocator_type()); }
+
+    bool        empty() const { return (!_sz); }
+    size_type   size() const { return (_sz); }
+    size_type   max_size() const { return node_allocator().max_size(); }
+
+    iterator                begin (void) const
+    { return (iterator::first(_root.get())); }
+    iterator                end (void) const
+    { return (iterator(_root.get())); }
+    reverse_iterator        rbegin (void) const
+    { return (end()); }
+    reverse_iterator        rend (void) const
+    { return (begin()); }
+
+    void swap (persistent_map& other)
+    {
+        ft::swap(_root, other._root);
+        ft::swap(_comp, other._comp);
+        ft::swap(_sz, other._sz);
+    }
+private:
+    static void release(link n)
+    {
+        if (!n || !n->release())
+            return ;
+        release(n->left);
+        release(n->right);
+        node_allocator  alloc;
+        n->~node_type();
+        alloc.deallocate(const_cast<node_type*>(n), 1);
+    }
+
+    static node_ptr make(bool red, link left, const value_type& value, link right)
+    {
+        node_allocator  alloc;
+        node_type*      n = alloc.allocate(1);
+        try {
+            ::new (static_cast<void*>(n)) node_type(value, red, left, right);
+        } catch (...) {
+            alloc.deallocate(n, 1);
+            throw ;
+        }
+        return (node_ptr::adopt(n));
+    }
+
+    static bool is_red(link n)
+    { return (n && n->red); }
+
+    static bool is_black(link n)
+    { return (n && !n->red); }
+
+    static node_ptr blacken(const node_ptr& n)
+    {
+        if (!is_red(n.get()))
+            return (n);
+        return (make(false, n->left, n->data, n->right));
+    }
+
+    static node_ptr redden(link n)
+    { return (make(true, n->left, n->data, n->right)); }
+
+    static node_ptr balance(link a, const value_type& x, link b)
+    {
+        if (is_red(a) && is_red(b))
+            return (make(true, make(false, a->left, a->data, a->right).get(), x,
+                               make(false, b->left, b->data, b->right).get()));
+        if (is_red(a) && is_red(a->left))
+            return (make(true, make(false, a->left->left, a->left->data, a->left->right).get(), a->data,
+                               make(false, a->right, x, b).get()));
+        if (is_red(a) && is_red(a->right))
+            return (make(true, make(false, a->left, a->data, a->right->left).get(), a->right->data,
+                               make(false, a->right->right, x, b).get()));
+        if (is_red(b) && is_red(b->right))
+            return (make(true, make(false, a, x, b->left).get(), b->data,
+                               make(false, b->right->left, b->right->data, b->right->right).get()));
+        if (is_red(b) && is_red(b->left))
+            return (make(true, make(false, a, x, b->left->left).get(), b->left->data,
+                               make(false, b->left->right, b->data, b->right).get()));
+        return (make(false, a, x, b));
+    }
+
+    // Sets found when the key is already there and pushes the nodes it
+    // passes onto path. Without assign the tree is then left as it is, path
+    // leads to the key, and a null handle comes back up so that nothing is
+    // retained or rebuilt on the way out.
+    node_ptr    ins(link n, const value_type& value, bool assign, bool& found, iterator& path) const
+    {
+        if (!n)
+            return (make(true, nullptr, value, nullptr));
+        path.push(n);
+        if (_comp(value.first, n->data.first))
+        {
+            node_ptr    l = ins(n->left, value, assign, found, path);
+            if (found && !assign)
+                return (l);
+            if (n->red)
+                return (make(true, l.get(), n->data, n->right));
+            return (balance(l.get(), n->data, n->right));
+        }
+        if (_comp(n->data.first, value.first))
+        {
+            node_ptr    r = ins(n->right, value, assign, found, path);
+            if (found && !assign)
+                return (r);
+            if (n->red)
+                return (make(true, n->left, n->data, r.get()));
+            return (balance(n->left, n->data, r.get()));
+        }
+        found = true;
+        if (assign)
+            return (make(n->red, n->left, value, n->right));
+        return (node_ptr());
+    }
+
+    static node_ptr bal_left(link l, const value_type& x, link r)
+    {
+        if (is_red(l))
+            return (make(true, make(false, l->left, l->data, l->right).get(), x, r));
+        if (is_black(r))
+            return (balance(l, x, redden(r).get()));
+        return (make(true, make(false, l, x, r->left->left).get(), r->left->data,
+                           balance(r->left->right, r->data, redden(r->right).get()).get()));
+    }
+
+    static node_ptr bal_right(link l, const value_type& x, link r)
+    {
+        if (is_red(r))
+            return (make(true, l, x, make(false, r->left, r->data, r->right).get()));
+        if (is_black(l))
+            return (balance(redden(l).get(), x, r));
+        return (make(true, balance(redden(l->left).get(), l->data, l->right->left).get(), l->right->data,
+                           make(false, l->right->right, x, r).get()));
+    }
+
+    static node_ptr append(link l, link r)
+    {
+        if (!l)
+            return (node_ptr(r));
+        if (!r)
+            return (node_ptr(l));
+        if (l->red && r->red)
+        {
+            node_ptr    m = append(l->right, r->left);
+            if (is_red(m.get()))
+                return (make(true, make(true, l->left, l->data, m->left).get(), m->data,
+                                   make(true, m->right, r->data, r->right).get()));
+            return (make(true, l->left, l->data, make(true, m.get(), r->data, r->right).get()));
+        }
+        if (!l->red && !r->red)
+        {
+            node_ptr    m = append(l->right, r->left);
+            if (is_red(m.get()))
+                return (make(true, make(false, l->left, l->data, m->left).get(), m->data,
+                                   make(false, m->right, r->data, r->right).get()));
+            return (bal_left(l->left, l->data, make(false, m.get(), r->data, r->right).get()));
+        }
+        if (r->red)
+            return (make(true, append(l, r->left).get(), r->data, r->right));
+        return (make(true, l->left, l->data, append(l->right, r).get()));
+    }
+
+    node_ptr    del(link n, const Key& key) const
+    {
+        if (_comp(key, n->data.first))
+        {
+            if (is_black(n->left))
+                return (bal_left(del(n->left, key).get(), n->data, n->right));
+            return (make(true, del(n->left, key).get(), n->data, n->right));
+        }
+        if (_comp(n->data.first, key))
+        {
+            if (is_black(n->right))
+                return (bal_right(n->left, n->data, del(n->right, key).get()));
+            return (make(true, n->left, n->data, del(n->right, key).get()));
+        }
+        return (append(n->left, n->right));
+    }
+};
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator< (const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return ft::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator==(const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return v1.size() == v2.size() && ft::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator!=(const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return !operator==(v1, v2);
+}
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator<=(const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return (!operator<(v2, v1));
+}
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator> (const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return operator<(v2, v1);
+}
+
+template< class Key, class T, class Compare, class Allocator >
+bool operator>=(const persistent_map<Key, T,Compare, Allocator >& v1, const persistent_map<Key, T,Compare, Allocator > & v2)
+{
+    return (!operator<(v1, v2));
+}
+
+template< class Key, class T, class Compare, class Allocator >
+void swap(persistent_map<Key, T,Compare, Allocator >& x, persistent_map<Key, T,Compare, Allocator > & y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef PREFIXED_STRING_HPP
+# define PREFIXED_STRING_HPP
+
+# include <cstring>
+# include <functional>
+# include <ostream>
+# include <string>
+# include <stdint.h>
+
+# include "compare.hpp"
+
+namespace ft {
+
+// A std::string key that carries its first eight bytes inline as a
+// big-endian integer, zero-padded. Stored in a map or set node, that
+// integer sits next to the node's links, so most comparisons on the way
+// down are settled by one integer compare without touching the string's
+// heap buffer; only keys that share their first eight bytes compare the
+// rest. The order is std::string's.
+class prefixed_string
+{
+public:
+    static const size_t prefix_size = sizeof(uint64_t);
+private:
+    uint64_t    _prefix;
+    std::string _str;
+
+    static uint64_t make_prefix(const std::string& s)
+    {
+        uint64_t    p = 0;
+        size_t      n = s.size();
+        if (n > prefix_size)
+            n = prefix_size;
+        for (size_t i = 0; i < prefix_size; ++i)
+            p = (p << 8) | (i < n ? uint64_t(static_cast<unsigned char>(s[i])) : 0);
+        return (p);
+    }
+public:
+    prefixed_string() : _prefix(0)
+    {}
+
+    prefixed_string(const std::string& s) : _prefix(make_prefix(s)), _str(s)
+    {}
+
+    prefixed_string(const char* s) : _str(s)
+    { _prefix = make_prefix(_str); }
+
+    const std::string&  str() const
+    { return (_str); }
+
+    operator const std::string&() const
+    { return (_str); }
+
+    uint64_t            prefix() const
+    { return (_prefix); }
+
+    size_t              size() const
+    { return (_str.size()); }
+
+    bool                empty() const
+    { return (_str.empty()); }
+
+    const char*         c_str() const
+    { return (_str.c_str()); }
+
+    // Same sign as str().compare(x.str()). Equal prefixes mean the common
+    // bytes agree as far as the shorter string goes, if it fits in the
+    // prefix; past that, only the bytes after the prefix are compared.
+    int                 compare(const prefixed_string& x) const
+    {
+        if (_prefix != x._prefix)
+            return (_prefix < x._prefix ? -1 : 1);
+        size_t  a = _str.size();
+        size_t  b = x._str.size();
+        if (a > prefix_size && b > prefix_size)
+        {
+            size_t  n = (a < b ? a : b) - prefix_size;
+            if (int c = std::memcmp(_str.data() + prefix_size, x._str.data() + prefix_size, n))
+                return (c);
+        }
+        return (a < b ? -1 : a > b);
+    }
+};
+
+inline bool operator==(const prefixed_string& x, const prefixed_string& y)
+{ return (x.prefix() == y.prefix() && x.str() == y.str()); }
+
+inline bool operator!=(const prefixed_string& x, const prefixed_string& y)
+{ return (!(x == y)); }
+
+inline bool operator<(const prefixed_string& x, const prefixed_string& y)
+{ return (x.compare(y) < 0); }
+
+inline bool operator>(const prefixed_string& x, const prefixed_string& y)
+{ return (y < x); }
+
+inline bool operator<=(const prefixed_string& x, const prefixed_string& y)
+{ return (!(y < x)); }
+
+inline bool operator>=(const prefixed_string& x, const prefixed_string& y)
+{ return (!(x < y)); }
+
+inline std::ostream&    operator<<(std::ostream& out, const prefixed_string& x)
+{ return (out << x.str()); }
+
+template <>
+struct three_way_compare<std::less<prefixed_string>, prefixed_string>
+{
+    static const bool value = true;
+
+    static int  compare(const std::less<prefixed_string>&, const prefixed_string& a, const prefixed_string& b)
+    { return (a.compare(b)); }
+};
+
+template <>
+struct three_way_compare<std::greater<prefixed_string>, prefixed_string>
+{
+    static const bool value = true;
+
+    static int  compare(const std::greater<prefixed_string>&, const prefixed_string& a, const prefixed_string& b)
+    { return (b.compare(a)); }
+};
+
+}
+
+#endif
@@ -0,0 +1,1273 @@
+#ifndef RB_TREE_HPP
+# define RB_TREE_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+# include <string>
+
+# include "BidirectionalIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "node.hpp"
+# include "stats.hpp"
+# include "memory.hpp"
+# include "vector.hpp"
+# include "compare.hpp"
+
+// Starts loading the cache line at p without waiting for it.
+# if defined(__GNUG__)
+#  define FT_PREFETCH(p) __builtin_prefetch(p)
+# else
+#  define FT_PREFETCH(p) ((void)0)
+# endif
+
+namespace ft{
+
+// Shape of a red-black tree. Depths count nodes, so the root is at depth 1
+// and height is the depth of the deepest node; a leaf is a node with no
+// children. black_height counts the black nodes on any path from the root
+// down to a missing child, and depths[d] is the number of nodes at depth d.
+struct tree_shape
+{
+    size_t          size;
+    size_t          height;
+    size_t          black_height;
+    size_t          min_leaf_depth;
+    size_t          max_leaf_depth;
+    vector<size_t>  depths;
+
+    tree_shape() : size(0), height(0), black_height(0), min_leaf_depth(0), max_leaf_depth(0)
+    {}
+};
+
+// Red-black tree shared by map, multimap, set and multiset. Values are
+// ordered by the key KeyOfValue extracts from them; the tree allocates
+// node<Value> through Alloc rebound to the node type.
+//
+// Two fictive nodes bracket the sequence: _first hangs off the leftmost
+// node and points back at it, _last does the same on the right. end() is
+// _last, and begin() is reached through _first->parent.
+template< class Key, class Value, class KeyOfValue, class Compare, class Alloc >
+class rb_tree
+{
+public:
+    typedef Key                                                                 key_type;
+    typedef Value                                                               value_type;
+    typedef Compare                                                             key_compare;
+    typedef Alloc                                                               allocator_type;
+    typedef size_t                                                              size_type;
+    typedef ptrdiff_t                                                           difference_type;
+    typedef node<value_type>                                                    node_type;
+    typedef BidirectionalIterator<value_type, value_type*, value_type&>         iterator;
+    typedef BidirectionalIterator<value_type, const value_type*, const value_type&> const_iterator;
+private:
+    typedef typename Alloc::template rebind<node_type>::other                  node_allocator;
+
+    node_type*          _head;
+    node_type*          _first;
+    node_type*          _last;
+
+    node_allocator      _alloc;
+    key_compare         _comp;
+    size_type           _sz;
+public:
+    explicit rb_tree( const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+    : _head(nullptr), _first(nullptr), _last(nullptr), _alloc(alloc), _comp(comp), _sz(0)
+    { init_map(); }
+
+    rb_tree( const rb_tree& other )
+    : _head(nullptr), _first(nullptr), _last(nullptr), _alloc(other._alloc), _comp(other._comp), _sz(0)
+    {
+        init_map();
+        copy(other);
+    }
+
+    rb_tree& operator= (const rb_tree& x)
+    {
+        if (this != &x) {
+            clear();
+            _comp = x._comp;
+            copy(x);
+        }
+        return (*this);
+    }
+
+    ~rb_tree()
+    {
+        clear();
+        _alloc.destroy(_first);
+        _alloc.deallocate(_first, 1);
+        _alloc.destroy(_last);
+        _alloc.deallocate(_last, 1);
+    }
+
+    void clear()
+    {
+        if (!empty())
+            clear(_head);
+        _head = nullptr;
+        _first->parent = _last;
+        _last->parent = _first;
+        reset_threads();
+    }
+
+    // Replaces the contents with the n values read from first, which must
+    // come in key order. Each subtree takes the middle of its range, so the
+    // tree is built in one linear pass; when the last level is not full,
+    // its nodes are red and every path keeps the same black height.
+    template <class InputIterator>
+    void assign_sorted( InputIterator first, size_type n )
+    {
+        clear();
+        if (!n)
+            return ;
+        _head = build_sorted(first, n, 0, red_depth(n));
+        bind_ends();
+    }
+
+    // Inserts the n values of [first, last), which must come in key order,
+    // as insert_unique would: of several equal keys the first one wins, and
+    // a key already in the tree is left alone. key_of extracts the key from
+    // the range's elements. A batch smaller than the tree is inserted one
+    // value at a time, each search starting from where the previous value
+    // landed. A larger one is merged with the tree's nodes and the whole
+    // tree relinked in balanced shape, with no rotation at all; below that
+    // size, walking every node costs more than the rebalancing it saves.
+    // Returns how many values were inserted.
+    template <class ForwardIterator, class KeyOf>
+    size_type merge_unique( ForwardIterator first, ForwardIterator last, size_type n, KeyOf key_of )
+    {
+        if (n >= _sz)
+            return (merge_relink(first, last, n, key_of));
+        size_type   inserted = 0;
+        node_type*  finger = nullptr;
+        for ( ; first != last; ++first)
+        {
+            node_type*  from = finger ? climb(finger, key_of(*first)) : _head;
+            pair<node_type*, bool>  res = insert_unique_below(from, *first, key_of(*first));
+            finger = res.first;
+            inserted += res.second;
+        }
+        return (inserted);
+    }
+
+    pair<iterator, bool> insert_unique( const value_type& value )
+    {
+        pair<node_type*, bool>  res = insert_unique_below(_head, value, KeyOfValue()(value));
+        return (ft::make_pair(iterator(res.first), res.second));
+    }
+
+    // Equal keys go to the right, so a new value lands after its equals.
+    iterator insert_equal( const value_type& value )
+    {
+        if (!_sz)
+            return (iterator(insert_head(value)));
+        node_type*  n = _head;
+        while (true)
+        {
+            if (key_less(KeyOfValue()(value), key(n)))
+            {
+                if (n->left && n->left != _first)
+                    n = n->left;
+                else
+                    return (iterator(insert_left(n, value)));
+            }
+            else
+            {
+                if (n->right && n->right != _last)
+                    n = n->right;
+                else
+                    return (iterator(insert_right(n, value)));
+            }
+        }
+    }
+
+    void erase( const_iterator pos )
+    {
+        node_type*  n = pos._ptr;
+        if (!valid_node(n))
+            return ;
+        unthread(n);
+        delete_node(n);
+        destroy_node(n);
+        --_sz;
+    }
+
+    void erase( const_iterator first, const_iterator last )
+    {
+        if (first == begin() && last == end()) {
+            clear();
+            return ;
+        }
+        while (first != last)
+            erase(first++);
+    }
+
+    size_type erase( const key_type& k )
+    {
+        pair<iterator, iterator>    range = equal_range(k);
+        size_type                   n = 0;
+        while (range.first != range.second)
+        {
+            erase(range.first++);
+            ++n;
+        }
+        return (n);
+    }
+
+    iterator find( const key_type& k )
+    { return (iterator(find_node(k))); }
+
+    const_iterator find( const key_type& k ) const
+    { return (const_iterator(find_node(k))); }
+
+    // Writes find(k) to out for each key of [first, last), in order. The
+    // keys are looked up find_lanes at a time with their descents
+    // interleaved: each round moves every lane down one level and
+    // prefetches the child it lands on, so the cache misses of a group
+    // overlap instead of queueing behind each other. Each key is read
+    // several times, so the range must be multi-pass.
+    template <class ForwardIterator, class OutputIterator>
+    OutputIterator find_many( ForwardIterator first, ForwardIterator last, OutputIterator out )
+    { return (find_interleaved<iterator>(first, last, out)); }
+
+    template <class ForwardIterator, class OutputIterator>
+    OutputIterator find_many( ForwardIterator first, ForwardIterator last, OutputIterator out ) const
+    { return (find_interleaved<const_iterator>(first, last, out)); }
+
+    size_type count( const key_type& k ) const
+    {
+        size_type       n = 0;
+        const_iterator  it = lower_bound(k);
+        for (const_iterator end_it = end(); it != end_it && !key_less(k, KeyOfValue()(*it)); ++it)
+            ++n;
+        return (n);
+    }
+
+    iterator lower_bound( const key_type& k )
+    { return (iterator(lower_bound_node(k))); }
+
+    const_iterator lower_bound( const key_type& k ) const
+    { return (const_iterator(lower_bound_node(k))); }
+
+    iterator upper_bound( const key_type& k )
+    { return (iterator(upper_bound_node(k))); }
+
+    const_iterator upper_bound( const key_type& k ) const
+    { return (const_iterator(upper_bound_node(k))); }
+
+    pair<iterator,iterator> equal_range( const key_type& k )
+    { return ft::make_pair(lower_bound(k), upper_bound(k)); }
+
+    pair<const_iterator,const_iterator> equal_range( const key_type& k ) const
+    { return ft::make_pair(lower_bound(k), upper_bound(k)); }
+
+    key_compare     key_comp() const
+    { return (_comp); }
+
+    allocator_type  get_allocator() const
+    { return (allocator_type(_alloc)); }
+
+    bool        empty() const { return (!_sz); }
+    size_type   size() const { return (_sz); }
+    size_type   max_size() const { return _alloc.max_size(); }
+
+    // Counters shared by every tree over the same node type.
+    static container_stats& stats()
+    { return (stats_of<node_type>::get()); }
+
+    // Every element costs a whole node, and the two sentinels are on top.
+    // With an allocator that knows its block sizes this visits every node.
+    memory_report   memory_usage() const
+    {
+        memory_report   r;
+        r.elements = _sz;
+        r.payload = _sz * sizeof(value_type);
+        r.requested = (_sz + 2) * sizeof(node_type);
+        if (allocation_size<node_allocator>::exact)
+            r.reserved = reserved_bytes(_head)
+                         + allocation_size<node_allocator>::reserved(_first, sizeof(node_type))
+                         + allocation_size<node_allocator>::reserved(_last, sizeof(node_type));
+        else
+            r.reserved = r.requested;
+        r.header = sizeof(*this);
+        return (r);
+    }
+
+    // Walks the whole tree once.
+    tree_shape      tree_stats() const
+    {
+        tree_shape  s;
+        s.size = _sz;
+        if (empty())
+            return (s);
+        s.depths.push_back(0);
+        shape(_head, 1, s);
+        for (const node_type* n = _head; valid_node(n); n = n->left)
+            s.black_height += !n->red;
+        return (s);
+    }
+
+# ifndef NDEBUG
+    // Checks every red-black, ordering and linkage invariant the tree relies
+    // on and throws std::logic_error naming the first one that is broken.
+    // Linear in the size; meant for tests and debugging sessions.
+    void            validate() const
+    {
+        if (empty())
+        {
+            check(!_head, "empty tree with a root");
+            check(_first->parent == _last && _last->parent == _first, "empty tree with bound sentinels");
+            return ;
+        }
+        check(!_head->parent, "root with a parent");
+        check(!_head->red, "red root");
+        size_type   count = 0;
+        validate(_head, count);
+        check(count == _sz, "size does not match the node count");
+        node_type*  n = _head;
+        while (valid_node(n->left))
+            n = n->left;
+        check(n->left == _first && _first->parent == n, "_first not bound to the leftmost node");
+        n = _head;
+        while (valid_node(n->right))
+            n = n->right;
+        check(n->right == _last && _last->parent == n, "_last not bound to the rightmost node");
+        const node_type*    prev = _first;
+        count = 0;
+        for (const_iterator it = begin(); it != end(); ++it, ++count)
+        {
+            const node_type*    cur = it._ptr;
+            check(count < _sz, "in-order walk does not reach end()");
+            check(prev == _first || !key_less(key(cur), key(prev)), "keys out of order");
+#  ifdef FT_THREADED_TREE
+            check(cur->pred == prev && prev->succ == cur, "threads out of step with the tree");
+#  endif
+            prev = cur;
+        }
+        check(count == _sz, "in-order walk stops short of end()");
+#  ifdef FT_THREADED_TREE
+        check(prev->succ == _last && _last->pred == prev, "last thread not bound to _last");
+#  endif
+    }
+# endif
+
+    iterator        begin (void)
+    { return (_first->parent); }
+    const_iterator  begin (void) const
+    { return (_first->parent); }
+    iterator        end (void)
+    { return (_last); }
+    const_iterator  end (void) const
+    { return (_last); }
+
+    // Writes iterators that cut the sequence into about `parts` contiguous
+    // ranges, begin() first and end() last. The cuts are the nodes of the
+    // top levels of the tree, so each range is a whole subtree below them
+    // plus the cut node that starts it.
+    template <class OutputIterator>
+    OutputIterator  split(size_type parts, OutputIterator out) const
+    {
+        int depth = 0;
+        while ((size_type(1) << depth) < parts)
+            ++depth;
+        *out++ = const_cast<node_type*>(_first->parent);
+        if (!empty())
+            out = split(_head, depth, out);
+        *out++ = _last;
+        return (out);
+    }
+
+    void swap (rb_tree& other)
+    {
+        ft::swap(_sz, other._sz);
+        ft::swap(_alloc, other._alloc);
+        ft::swap(_head, other._head);
+        ft::swap(_first, other._first);
+        ft::swap(_last, other._last);
+        ft::swap(_comp, other._comp);
+    }
+private:
+    static const key_type&  key(const node_type* n)
+    { return (KeyOfValue()(n->data)); }
+
+    bool            key_less(const key_type& a, const key_type& b) const
+    {
+        FT_STATS_ADD(stats(), comparisons, 1);
+        return (_comp(a, b));
+    }
+
+    // Negative, zero or positive as a sorts before, with or after b: one
+    // comparator call when three_way_compare knows Compare, two otherwise.
+    int             key_order(const key_type& a, const key_type& b) const
+    { return (key_order(a, b, std::integral_constant<bool, three_way_compare<Compare, Key>::value>())); }
+
+    int             key_order(const key_type& a, const key_type& b, std::true_type) const
+    {
+        FT_STATS_ADD(stats(), comparisons, 1);
+        return (three_way_compare<Compare, Key>::compare(_comp, a, b));
+    }
+
+    int             key_order(const key_type& a, const key_type& b, std::false_type) const
+    { return (key_less(a, b) ? -1 : key_less(b, a) ? 1 : 0); }
+
+    node_type*      create_node(const value_type& value, bool red = true)
+    {
+        node_type*  n = _alloc.allocate(1);
+        try {
+            _alloc.construct(n, node_type(value, red));
+        } catch (...) {
+            _alloc.deallocate(n, 1);
+            throw ;
+        }
+        FT_STATS_ADD(stats(), allocations, 1);
+        return (n);
+    }
+
+    void            destroy_node(node_type* n)
+    {
+        _alloc.destroy(n);
+        _alloc.deallocate(n, 1);
+        FT_STATS_ADD(stats(), deallocations, 1);
+    }
+
+    template <class OutputIterator>
+    OutputIterator  split(node_type* n, int depth, OutputIterator out) const
+    {
+        if (!valid_node(n) || !depth)
+            return (out);
+        out = split(n->left, depth - 1, out);
+        if (n != _first->parent)
+            *out++ = n;
+        return (split(n->right, depth - 1, out));
+    }
+
+    // Descents in flight at once in find_many: enough to cover the memory
+    // latency, few enough for the lanes to stay in registers.
+    static const size_t find_lanes = 8;
+
+    // Below this many bytes of nodes the tree mostly stays in cache, there
+    // are few misses to overlap, and the bookkeeping of the lanes costs
+    // more than it hides; plain finds are used instead.
+    static const size_t find_cached_bytes = size_t(4) << 20;
+
+    template <class Result, class ForwardIterator, class OutputIterator>
+    OutputIterator  find_interleaved(ForwardIterator first, ForwardIterator last, OutputIterator out) const
+    {
+        if (_sz * sizeof(node_type) < find_cached_bytes)
+        {
+            for ( ; first != last; ++first)
+                *out++ = Result(find_node(*first));
+            return (out);
+        }
+        ForwardIterator keys[find_lanes];
+        node_type*      cur[find_lanes];
+        node_type*      res[find_lanes];
+        while (first != last)
+        {
+            size_t  lanes = 0;
+            for ( ; lanes < find_lanes && first != last; ++lanes, ++first)
+            {
+                keys[lanes] = first;
+                cur[lanes] = _head;
+                res[lanes] = _last;
+            }
+            // Same walk as lower_bound_node, one level per lane per round.
+            // A lane only reads the node it prefetched a round earlier.
+            for (bool more = true; more; )
+            {
+                more = false;
+                for (size_t i = 0; i < lanes; ++i)
+                {
+                    node_type*  n = cur[i];
+                    if (!valid_node(n))
+                        continue ;
+                    more = true;
+                    // Selects rather than branches: which way a lane goes
+                    // is a coin flip the predictor cannot learn.
+                    bool    left = !key_less(key(n), *keys[i]);
+                    res[i] = left ? n : res[i];
+                    n = left ? n->left : n->right;
+                    FT_PREFETCH(n);
+                    cur[i] = n;
+                }
+            }
+            for (size_t i = 0; i < lanes; ++i)
+            {
+                if (res[i] != _last && key_less(*keys[i], key(res[i])))
+                    res[i] = _last;
+                *out++ = Result(res[i]);
+            }
+        }
+        return (out);
+    }
+
+    node_type*      find_node(const key_type& k) const
+    {
+        node_type*  n = lower_bound_node(k);
+        if (n != _last && key_less(k, key(n)))
+            return (_last);
+        return (n);
+    }
+
+    node_type*      lower_bound_node(const key_type& k) const
+    {
+        node_type*  n = _head;
+        node_type*  res = _last;
+        while (valid_node(n))
+        {
+            if (!key_less(key(n), k))
+            {
+                res = n;
+                n = n->left;
+            }
+            else
+                n = n->right;
+        }
+        return (res);
+    }
+
+    node_type*      upper_bound_node(const key_type& k) const
+    {
+        node_type*  n = _head;
+        node_type*  res = _last;
+        while (valid_node(n))
+        {
+            if (key_less(k, key(n)))
+            {
+                res = n;
+                n = n->left;
+            }
+            else
+                n = n->right;
+        }
+        return (res);
+    }
+
+    // Copies the shape and colours of other's tree node for node, then
+    // hooks the fictive nodes onto the new leftmost and rightmost nodes.
+    void            copy(const rb_tree& other)
+    {
+        if (other.empty())
+            return ;
+        _head = clone(other._head, nullptr, other);
+        bind_ends();
+    }
+
+    // Hooks the fictive nodes onto the leftmost and rightmost nodes of a
+    // freshly built tree and threads it.
+    void            bind_ends()
+    {
+        node_type*  n = _head;
+        while (n->left)
+            n = n->left;
+        _first->parent = n;
+        n->left = _first;
+        n = _head;
+        while (n->right)
+            n = n->right;
+        _last->parent = n;
+        n->right = _last;
+        thread_subtree(_head, _first);
+    }
+
+    // Depth whose nodes build_sorted and link_sorted colour red, so that a
+    // tree of n nodes with a partial last level keeps one black height.
+    static size_type    red_depth(size_type n)
+    {
+        size_type   depth = 0;
+        for (difference_type m = difference_type(n) - 1; m >= 0; m = m / 2 - 1)
+            ++depth;
+        return (depth);
+    }
+
+    // Searches for k from n down, where n is the root or the top of a
+    // subtree that k's place is known to be in, and inserts value there
+    // unless k is already present.
+    template <class Value2>
+    pair<node_type*, bool>  insert_unique_below(node_type* n, const Value2& value, const key_type& k)
+    {
+        if (!_sz)
+            return (ft::make_pair(insert_head(value), true));
+        while (true)
+        {
+            int order = key_order(k, key(n));
+            if (order < 0)
+            {
+                if (n->left && n->left != _first)
+                    n = n->left;
+                else
+                    return (ft::make_pair(insert_left(n, value), true));
+            }
+            else if (order > 0)
+            {
+                if (n->right && n->right != _last)
+                    n = n->right;
+                else
+                    return (ft::make_pair(insert_right(n, value), true));
+            }
+            else
+                return (ft::make_pair(n, false));
+        }
+    }
+
+    // Climbs from n, whose key is below k, to the lowest subtree that also
+    // holds k's place: a left child whose parent's key is above k bounds it
+    // on both sides. Neighbouring keys meet a few levels up instead of at
+    // the root.
+    node_type*      climb(node_type* n, const key_type& k) const
+    {
+        while (n->parent)
+        {
+            if (n == n->parent->left && key_less(k, key(n->parent)))
+                break ;
+            n = n->parent;
+        }
+        return (n);
+    }
+
+    template <class ForwardIterator, class KeyOf>
+    size_type       merge_relink(ForwardIterator first, ForwardIterator last, size_type n, KeyOf key_of)
+    {
+        vector<node_type*>  nodes;
+        vector<node_type*>  fresh;
+        nodes.reserve(_sz + n);
+        fresh.reserve(n);
+        node_type*          t = _first->parent;
+        try {
+            for ( ; first != last; ++first)
+            {
+                const key_type& k = key_of(*first);
+                while (t != _last && key_less(key(t), k))
+                {
+                    nodes.push_back(t);
+                    node_type::next(t);
+                }
+                if (!nodes.empty() && !key_less(key(nodes.back()), k))
+                    continue ;
+                if (t != _last && !key_less(k, key(t)))
+                {
+                    nodes.push_back(t);
+                    node_type::next(t);
+                    continue ;
+                }
+                fresh.push_back(create_node(*first));
+                nodes.push_back(fresh.back());
+            }
+        } catch (...) {
+            for (typename vector<node_type*>::iterator it = fresh.begin(); it != fresh.end(); ++it)
+                destroy_node(*it);
+            throw ;
+        }
+        for ( ; t != _last; node_type::next(t))
+            nodes.push_back(t);
+        if (fresh.empty())
+            return (0);
+        _head = link_sorted(nodes.data(), nodes.size(), 0, red_depth(nodes.size()));
+        _head->parent = nullptr;
+        _sz = nodes.size();
+        bind_ends();
+        return (fresh.size());
+    }
+
+    // build_sorted over nodes that already exist: the same shape and
+    // colours, only the links are rewritten.
+    node_type*      link_sorted(node_type* const* nodes, size_type count, size_type depth, size_type red_depth)
+    {
+        if (!count)
+            return (nullptr);
+        size_type   left_count = (count - 1) / 2;
+        node_type*  n = nodes[left_count];
+        n->red = depth == red_depth;
+        n->left = link_sorted(nodes, left_count, depth + 1, red_depth);
+        n->right = link_sorted(nodes + left_count + 1, count - 1 - left_count, depth + 1, red_depth);
+        if (n->left)
+            n->left->parent = n;
+        if (n->right)
+            n->right->parent = n;
+        return (n);
+    }
+
+    template <class InputIterator>
+    node_type*      build_sorted(InputIterator& first, size_type count, size_type depth, size_type red_depth)
+    {
+        if (!count)
+            return (nullptr);
+        size_type   left_count = (count - 1) / 2;
+        node_type*  left = build_sorted(first, left_count, depth + 1, red_depth);
+        node_type*  n = nullptr;
+        try {
+            n = create_node(*first, depth == red_depth);
+            ++_sz;
+            n->left = left;
+            if (left)
+                left->parent = n;
+            ++first;
+        } catch (...) {
+            clear(n ? n : left);
+            throw ;
+        }
+        try {
+            n->right = build_sorted(first, count - 1 - left_count, depth + 1, red_depth);
+        } catch (...) {
+            clear(n);
+            throw ;
+        }
+        if (n->right)
+            n->right->parent = n;
+        return (n);
+    }
+
+    node_type*      clone(const node_type* src, node_type* parent, const rb_tree& other)
+    {
+        if (!other.valid_node(src))
+            return (nullptr);
+        node_type*  n = create_node(src->data, src->red);
+        FT_STATS_ADD(stats(), copies, 1);
+        n->parent = parent;
+        ++_sz;
+        try {
+            n->left = clone(src->left, n, other);
+            n->right = clone(src->right, n, other);
+        } catch (...) {
+            clear(n);
+            if (!parent)
+                _head = nullptr;
+            throw ;
+        }
+        return (n);
+    }
+
+    size_t  reserved_bytes(const node_type* n) const
+    {
+        if (!valid_node(n))
+            return (0);
+        return (allocation_size<node_allocator>::reserved(n, sizeof(node_type))
+                + reserved_bytes(n->left) + reserved_bytes(n->right));
+    }
+
+    void    shape(const node_type* n, size_t depth, tree_shape& s) const
+    {
+        if (s.depths.size() <= depth)
+            s.depths.push_back(0);
+        ++s.depths[depth];
+        if (depth > s.height)
+            s.height = depth;
+        bool    left = valid_node(n->left);
+        bool    right = valid_node(n->right);
+        if (!left && !right)
+        {
+            if (!s.min_leaf_depth || depth < s.min_leaf_depth)
+                s.min_leaf_depth = depth;
+            if (depth > s.max_leaf_depth)
+                s.max_leaf_depth = depth;
+        }
+        if (left)
+            shape(n->left, depth + 1, s);
+        if (right)
+            shape(n->right, depth + 1, s);
+    }
+
+# ifndef NDEBUG
+    static void check(bool ok, const char* what)
+    {
+        if (!ok)
+            throw std::logic_error(std::string("rb_tree::validate: ") + what);
+    }
+
+    // Returns the black height of the subtree under n.
+    size_t  validate(const node_type* n, size_type& count) const
+    {
+        if (!valid_node(n))
+            return (0);
+        ++count;
+        check(count <= _sz, "more nodes than size()");
+        if (valid_node(n->left))
+            check(n->left->parent == n, "left child with a wrong parent");
+        if (valid_node(n->right))
+            check(n->right->parent == n, "right child with a wrong parent");
+        if (n->red)
+            check((!valid_node(n->left) || !n->left->red) && (!valid_node(n->right) || !n->right->red),
+                  "red node with a red child");
+        size_t  left = validate(n->left, count);
+        size_t  right = validate(n->right, count);
+        check(left == right, "unequal black heights");
+        return (left + !n->red);
+    }
+# endif
+
+    void    clear(node_type*    n)
+    {
+        if (!n)
+            return;
+        clear(n->left);
+        clear(n->right);
+        if (valid_node(n))
+        {
+            destroy_node(n);
+            --_sz;
+        }
+    }
+
+    node_type*      findSmallest(node_type* n)
+    {
+        n = n->right;
+        while (valid_node(n->left))
+            n = n->left;
+        return (n);
+    }
+
+    void            transplant(node_type* n, node_type* other_n)
+    {
+        bool c_tmp = n->red;
+        n->red = other_n->red;
+        other_n->red = c_tmp;
+
+        node_type* tmp = n->parent;
+        n->parent = other_n->parent;
+        other_n->parent = tmp;
+        if (!other_n->parent)
+            _head = other_n;
+        else if (n == other_n->parent->left) 
+			other_n->parent->left = other_n;
+		else 
+			other_n->parent->right = other_n;
+        if (other_n == n->parent->left)
+            n->parent->left = n;
+        else 
+			n->parent->right = n;
+
+        tmp = n->left;
+        n->left = other_n->left;
+        other_n->left = tmp;
+        
+        tmp = n->right;
+        n->right = other_n->right;
+        other_n->right = tmp;
+
+        if (n->left)
+            n->left->parent = n;
+        if (n->right)
+            n->right->parent = n;
+
+        if (other_n->left)
+            other_n->left->parent = other_n;
+        if (other_n->right)
+            other_n->right->parent = other_n;
+
+    }
+
+    node_type *sibling(node_type *n)
+    {
+    	if (n == n->parent->left)
+    		return n->parent->right;
+    	else
+    		return n->parent->left;
+    }
+
+    void delete_case6(node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	node_type *s = sibling(n);
+
+    	s->red = n->parent->red;
+        n->parent->red = false;
+
+    	if (n == n->parent->left) {
+            s->right->red = false;
+    		left_rot(n->parent);
+    	} else {
+    		s->left->red = false;
+    		right_rot(n->parent);
+    	}
+    }
+
+    void delete_case5(node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	node_type *s = sibling(n);
+
+    	if  (!s->red) // (!s->red && !n->parent->red) 
+        { 
+    		if ((n == n->parent->left) &&
+    		    (!valid_node(s->right) || !s->right->red) &&
+    		    (s->left->red)) 
+            { 
+    			s->red = true;
+    			s->left->red = false;
+    			right_rot(s);
+    		} 
+            else if ((n == n->parent->right) &&
+    		           (!valid_node(s->left) || !s->left->red) &&
+    		           (s->right->red)) 
+            {
+    			s->red = false;
+    			s->right->red = true;
+    			left_rot(s);
+    		}
+    	}
+    	delete_case6(n);
+    }
+
+    void delete_case4(node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	node_type *s = sibling(n);
+
+    	if (n->parent->red && !s->red && 
+            (!valid_node(s->left) || !s->left->red) && 
+            (!valid_node(s->right) || !s->right->red) ) 
+        {
+    		s->red = true;
+    		n->parent->red = false;
+    	} 
+        else
+    		delete_case5(n);
+    }
+
+    void delete_case3(node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	node_type *s = sibling(n);
+
+    	if (!n->parent->red && !s->red && (!valid_node(s->left) || !s->left->red) && 
+            (!valid_node(s->right) || !s->right->red)) 
+        {
+    		s->red = true;
+    		delete_case1(n->parent);
+    	} 
+        else
+    		delete_case4(n);
+    }
+
+    void delete_case2(node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	node_type *s = sibling(n);
+
+    	if (s->red) {
+    		n->parent->red = true;
+    		s->red = false;
+    		if (n == n->parent->left)
+    			left_rot(n->parent);
+    		else
+    			right_rot(n->parent);
+    	} 
+    	delete_case3(n);
+    }
+
+    void delete_case1( node_type *n)
+    {
+    	FT_STATS_ADD(stats(), rebalances, 1);
+    	if (n->parent)
+    		delete_case2(n);
+    }
+
+    void            bind_first_node(node_type* n)
+    {
+        if (valid_node(n->left))
+            n = n->left;
+        _first->parent = n;
+        n->left = _first;
+    }
+    void            bind_last_node(node_type* n)
+    {
+        if (valid_node(n->right))
+            n = n->right;
+        _last->parent = n;
+        n->right = _last;
+    }
+
+    void            deleteRoot(node_type* child)
+    {
+        if (_sz == 1)
+        {
+            _head = nullptr;
+            _first->parent = _last;
+            _last->parent = _first;
+        }
+        else if (valid_node(child))
+        {
+            _head = child;
+            child->parent = nullptr;
+            child->red = false;
+
+            _first->parent =  child;
+            child->left = _first;
+            _last->parent =  child;
+            child->right = _last;
+        }
+    }
+
+    node_type*      ret_child(node_type* n)
+    {
+        if (n == _first->parent)
+            return (n->right);
+        if (n == _last->parent)
+            return (n->left);
+        if (n->left)
+            return n->left;
+        if (n->right)
+            return n->right;
+        return (nullptr);
+    }
+    
+    void 
+    replace_node(node_type* n, node_type* child) 
+    {
+        if (child)
+            child->parent = n->parent;
+        if (n == n->parent->left) 
+            n->parent->left = child;
+        else
+            n->parent->right = child;
+
+    }
+
+    void            deleteOneChild(node_type*   n)
+    {
+        node_type*  child = ret_child(n);
+        if (n == _head)   {
+            deleteRoot(child);
+            return ;
+        }
+
+        if (!n->red)
+        {
+            if (valid_node(child) && child->red)
+                child->red = false;
+            else
+                delete_case1(n);
+        }
+
+        replace_node(n, child);
+        if (n == _first->parent)
+            bind_first_node(n->parent);
+        else if (n == _last->parent)
+            bind_last_node(n->parent); 
+    }
+
+    void            delete_node(node_type*  n)
+    {
+        if (n->right && n->left && n->right != _last && n->left != _first)
+        {
+            node_type* other_n = findSmallest(n);
+            transplant(n, other_n);
+        }
+        deleteOneChild(n);
+    }
+
+    bool            valid_node(const node_type* n) const
+    {
+        return (n && n != _first && n != _last);
+    }
+
+    node_type*      swap_col(node_type* head)
+    {
+        head->red           = true;
+        head->left->red     = false;
+        head->right->red    = false;
+        return (head);
+    }
+
+    void            left_rot(node_type* x)
+    {
+        FT_STATS_ADD(stats(), rotations, 1);
+        node_type*  y   = x->right;
+        x->right        = y->left;
+        y->parent       = x->parent;
+        y->left         = x;
+        x->parent       = y;
+        if (x->right)
+            x->right->parent = x;      
+        if (!y->parent)
+            _head = y;
+        else if (y->parent->left == x)
+            y->parent->left = y;
+        else
+            y->parent->right = y;
+    }
+
+    void            right_rot(node_type* x)
+    {
+        FT_STATS_ADD(stats(), rotations, 1);
+        node_type*  y   = x->left;
+        x->left         = y->right;
+        y->parent       = x->parent;
+        y->right        = x;
+        x->parent       = y;
+        if (x->left)
+            x->left->parent = x;      
+        if (!y->parent)
+            _head = y;
+        else if (y->parent->left == x)
+            y->parent->left = y;
+        else
+            y->parent->right = y;
+    }
+
+    void            balancing(node_type* new_node)
+    {
+		
+        while(new_node != _head && new_node->red && new_node->parent->red)
+        {
+            FT_STATS_ADD(stats(), rebalances, 1);
+            node_type*  parent  = new_node->parent;
+            node_type*  ded     = parent->parent;
+            if (parent == ded->left)
+            {
+                node_type*  uncle = ded->right;
+                if (valid_node(uncle) && uncle->red)
+                    new_node = swap_col(ded);
+                else if (new_node == parent->right)
+                {
+                    left_rot(parent);
+                    new_node = parent;
+                }
+                else
+                {
+                    right_rot(ded);
+                    ded->red = true;
+                    parent->red = false;
+                }
+            }
+            else if (parent == ded->right)
+            {
+                node_type*  uncle = ded->left;
+                if (valid_node(uncle) && uncle->red)
+                    new_node = swap_col(ded);
+                else if (new_node == parent->left)
+                {
+                    right_rot(parent);
+                    new_node = parent;
+                }
+                else
+                {
+                    left_rot(ded);
+                    ded->red = true;
+                    parent->red = false;
+                }
+            }
+        }
+        _head->red = false;
+    }
+
+    node_type*      insert_left(node_type* n, const value_type& value)
+    {
+        node_type* new_node = create_node(value);
+        new_node->parent = n;
+        thread_before(new_node, n);
+        new_node->left = n->left;
+        n->left ? n->left->parent = new_node : 0;
+        n->left = new_node;
+        ++_sz;
+        balancing(new_node);
+        return new_node;
+    }
+
+    node_type*      insert_right(node_type* n, const value_type& value)
+    {
+        node_type* new_node = create_node(value);
+        new_node->parent    = n;
+        thread_after(new_node, n);
+        new_node->right     = n->right;
+        n->right ? n->right->parent = new_node : 0;
+        n->right = new_node;
+        ++_sz;
+        balancing(new_node);
+        return new_node;
+    }
+
+    node_type*      insert_head(const value_type& value)
+    {
+        _head = create_node(value, false);
+        _first->parent  = _last->parent = _head;
+        _head->left     = _first;
+        _head->right    = _last;
+        thread_after(_head, _first);
+        ++_sz;
+        return _head;
+    }
+
+    void    init_map(void)
+    {
+        _first  = _alloc.allocate(1);
+        _last   = _alloc.allocate(1);
+        _alloc.construct(_first, node_type());
+        _alloc.construct(_last, node_type());
+        _first->parent  = _last;
+        _last->parent   = _first;
+        _last->fict = _first->fict = true;
+        reset_threads();
+    }
+
+    // In-order links for FT_THREADED_TREE. Rotations and transplant keep
+    // the in-order sequence, so only insertion and removal touch them.
+    void    reset_threads(void)
+    {
+# ifdef FT_THREADED_TREE
+        _first->succ = _last;
+        _last->pred = _first;
+# endif
+    }
+
+    void    thread_after(node_type* n, node_type* pos)
+    {
+# ifdef FT_THREADED_TREE
+        n->pred = pos;
+        n->succ = pos->succ;
+        pos->succ->pred = n;
+        pos->succ = n;
+# else
+        (void)n;
+        (void)pos;
+# endif
+    }
+
+    void    thread_before(node_type* n, node_type* pos)
+    {
+# ifdef FT_THREADED_TREE
+        thread_after(n, pos->pred);
+# else
+        (void)n;
+        (void)pos;
+# endif
+    }
+
+    void    unthread(node_type* n)
+    {
+# ifdef FT_THREADED_TREE
+        n->pred->succ = n->succ;
+        n->succ->pred = n->pred;
+# else
+        (void)n;
+# endif
+    }
+
+    // Links the subtree in order after prev; returns its last node.
+    node_type*  thread_subtree(node_type* n, node_type* prev)
+    {
+# ifdef FT_THREADED_TREE
+        if (!valid_node(n))
+            return (prev);
+        prev = thread_subtree(n->left, prev);
+        prev->succ = n;
+        n->pred = prev;
+        prev = thread_subtree(n->right, n);
+        if (n == _head)
+        {
+            prev->succ = _last;
+            _last->pred = prev;
+        }
+# else
+        (void)n;
+# endif
+        return (prev);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef SERIALIZE_HPP
+# define SERIALIZE_HPP
+
+# include <stdint.h>
+# include <cstring>
+# include <fstream>
+# include <istream>
+# include <ostream>
+# include <stdexcept>
+# include <string>
+# include <type_traits>
+
+# include "vector.hpp"
+# include "map.hpp"
+# include "pair.hpp"
+
+namespace ft {
+
+// Binary snapshots of vector and map. A vector of trivially copyable
+// elements goes out as one block straight from its buffer and comes back
+// the same way; anything else is written field by field. A map is written
+// in key order and reloaded with assign_sorted, so no key is compared.
+//
+// Raw blocks are only readable where T has the same size and byte order;
+// deserialize checks both and throws std::runtime_error on a mismatch, a
+// bad header or a short stream.
+struct serial_header
+{
+    char        magic[4];       // "FTV1" for a vector, "FTB1" for a vector<bool>, "FTM1" for a map
+    uint32_t    byte_order;     // serial_header::marker as the writer stored it
+    uint32_t    value_size;     // sizeof(T) for a raw block, 0 otherwise
+    uint32_t    flags;
+    uint64_t    count;
+
+    static const uint32_t   marker = 0x01020304;
+    static const uint32_t   raw_block = 1;
+};
+
+namespace serial_detail {
+
+inline void write_bytes(std::ostream& out, const void* p, size_t n)
+{
+    out.write(static_cast<const char*>(p), std::streamsize(n));
+    if (!out)
+        throw std::runtime_error("ft::serialize: write failed");
+}
+
+inline void read_bytes(std::istream& in, void* p, size_t n)
+{
+    in.read(static_cast<char*>(p), std::streamsize(n));
+    if (size_t(in.gcount()) != n)
+        throw std::runtime_error("ft::deserialize: truncated stream");
+}
+
+inline void write_header(std::ostream& out, const char* magic, uint64_t count, uint32_t value_size)
+{
+    serial_header   h;
+    std::memcpy(h.magic, magic, sizeof(h.magic));
+    h.byte_order = serial_header::marker;
+    h.value_size = value_size;
+    h.flags = value_size ? serial_header::raw_block : 0;
+    h.count = count;
+    write_bytes(out, &h, sizeof(h));
+}
+
+inline serial_header    read_header(std::istream& in, const char* magic, uint32_t value_size)
+{
+    serial_header   h;
+    read_bytes(in, &h, sizeof(h));
+    if (std::memcmp(h.magic, magic, sizeof(h.magic)))
+        throw std::runtime_error("ft::deserialize: not a snapshot of this container");
+    if (h.byte_order != serial_header::marker || h.value_size != value_size
+        || h.flags != (value_size ? serial_header::raw_block : 0))
+        throw std::runtime_error("ft::deserialize: element layout does not match");
+    return (h);
+}
+
+// One value, field by field. Trivially copyable types are copied as they
+// are. Other types can declare write_value and read_value overloads in
+// their own namespace, where argument-dependent lookup finds them.
+template <class T>
+void    write_value(std::ostream& out, const T& x)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ft::serialize: no write_value overload for this type");
+    write_bytes(out, &x, sizeof(x));
+}
+
+template <class T>
+void    read_value(std::istream& in, T& x)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ft::deserialize: no read_value overload for this type");
+    read_bytes(in, &x, sizeof(x));
+}
+
+inline void write_value(std::ostream& out, const std::string& x)
+{
+    uint64_t    len = x.size();
+    write_bytes(out, &len, sizeof(len));
+    write_bytes(out, x.data(), x.size());
+}
+
+inline void read_value(std::istream& in, std::string& x)
+{
+    uint64_t    len;
+    read_bytes(in, &len, sizeof(len));
+    x.resize(size_t(len));
+    if (len)
+        read_bytes(in, &x[0], size_t(len));
+}
+
+template <class A, class B>
+void    write_value(std::ostream& out, const pair<A, B>& x)
+{
+    write_value(out, x.first);
+    write_value(out, x.second);
+}
+
+template <class A, class B>
+void    read_value(std::istream& in, pair<A, B>& x)
+{
+    read_value(in, x.first);
+    read_value(in, x.second);
+}
+
+// Single-pass iterator over the next `count` values of a stream; it reads
+// one value ahead, so assign_sorted can build straight from the file.
+template <class T>
+class reader
+{
+    std::istream*   _in;
+    uint64_t        _left;
+    T               _value;
+public:
+    reader(std::istream& in, uint64_t count) : _in(&in), _left(count), _value()
+    {
+        if (_left)
+            read_value(*_in, _value);
+    }
+
+    const T&    operator*() const
+    { return (_value); }
+
+    reader&     operator++()
+    {
+        if (_left && --_left)
+            read_value(*_in, _value);
+        return (*this);
+    }
+};
+
+template <class T>
+struct is_raw : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{};
+
+template <class T, class Alloc>
+void    write_elements(std::ostream& out, const vector<T, Alloc>& v, std::true_type)
+{
+    if (!v.empty())
+        write_bytes(out, v.data(), v.size() * sizeof(T));
+}
+
+template <class T, class Alloc>
+void    write_elements(std::ostream& out, const vector<T, Alloc>& v, std::false_type)
+{
+    typedef typename vector<T, Alloc>::const_iterator  const_iterator;
+    for (const_iterator it = v.begin(); it != v.end(); ++it)
+        write_value(out, *it);
+}
+
+template <class T, class Alloc>
+void    read_elements(std::istream& in, vector<T, Alloc>& v, size_t count, std::true_type)
+{
+    v.resize(count);
+    if (count)
+        read_bytes(in, v.data(), count * sizeof(T));
+}
+
+template <class T, class Alloc>
+void    read_elements(std::istream& in, vector<T, Alloc>& v, size_t count, std::false_type)
+{
+    v.reserve(count);
+    T   x;
+    for (size_t i = 0; i < count; ++i)
+    {
+        read_value(in, x);
+        v.push_back(x);
+    }
+}
+
+// Large enough that field-by-field writes do not turn into one system
+// call per few kilobytes.
+static const size_t file_buffer_size = size_t(1) << 20;
+
+}
+
+template <class T, class Alloc>
+void    serialize(std::ostream& out, const vector<T, Alloc>& v)
+{
+    typedef serial_detail::is_raw<T>    raw;
+    serial_detail::write_header(out, "FTV1", v.size(), raw::value ? uint32_t(sizeof(T)) : 0);
+    serial_detail::write_elements(out, v, raw());
+}
+
+// Replaces the contents of v with the snapshot at the current position.
+template <class T, class Alloc>
+void    deserialize(std::istream& in, vector<T, Alloc>& v)
+{
+    typedef serial_detail::is_raw<T>    raw;
+    serial_header   h = serial_detail::read_header(in, "FTV1", raw::value ? uint32_t(sizeof(T)) : 0);
+    if (h.count > v.max_size())
+        throw std::runtime_error("ft::deserialize: element count out of range");
+    v.clear();
+    serial_detail::read_elements(in, v, size_t(h.count), raw());
+}
+
+// vector<bool> has no bool array to copy: its packed words go out as one
+// raw block, with the bit count in the header.
+template <class Alloc>
+void    serialize(std::ostream& out, const vector<bool, Alloc>& v)
+{
+    serial_detail::write_header(out, "FTB1", v.size(), uint32_t(sizeof(bit_word)));
+    if (v.word_count())
+        serial_detail::write_bytes(out, v.words(), v.word_count() * sizeof(bit_word));
+}
+
+template <class Alloc>
+void    deserialize(std::istream& in, vector<bool, Alloc>& v)
+{
+    serial_header   h = serial_detail::read_header(in, "FTB1", uint32_t(sizeof(bit_word)));
+    if (h.count > v.max_size())
+        throw std::runtime_error("ft::deserialize: element count out of range");
+    v.clear();
+    v.resize(size_t(h.count));
+    if (!v.word_count())
+        return ;
+    serial_detail::read_bytes(in, v.words(), v.word_count() * sizeof(bit_word));
+    if (size_t tail = size_t(h.count) % bit_word_bits)
+        v.words()[v.word_count() - 1] &= (bit_word(1) << tail) - 1;
+}
+
+template <class Key, class T, class Compare, class Alloc>
+void    serialize(std::ostream& out, const map<Key, T, Compare, Alloc>& m)
+{
+    typedef typename map<Key, T, Compare, Alloc>::const_iterator    const_iterator;
+    serial_detail::write_header(out, "FTM1", m.size(), 0);
+    for (const_iterator it = m.begin(); it != m.end(); ++it)
+        serial_detail::write_value(out, *it);
+}
+
+// The snapshot must come from a map ordered by the same comparator.
+template <class Key, class T, class Compare, class Alloc>
+void    deserialize(std::istream& in, map<Key, T, Compare, Alloc>& m)
+{
+    serial_header   h = serial_detail::read_header(in, "FTM1", 0);
+    if (h.count > m.max_size())
+        throw std::runtime_error("ft::deserialize: element count out of range");
+    serial_detail::reader<pair<Key, T> >    first(in, h.count);
+    m.assign_sorted(first, size_t(h.count));
+}
+
+template <class Container>
+void    serialize(const char* path, const Container& c)
+{
+    vector<char>    buffer(serial_detail::file_buffer_size);
+    std::ofstream   out;
+    out.rdbuf()->pubsetbuf(buffer.data(), std::streamsize(buffer.size()));
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error(std::string("ft::serialize: cannot open ") + path);
+    serialize(static_cast<std::ostream&>(out), c);
+    out.close();
+    if (!out)
+        throw std::runtime_error(std::string("ft::serialize: cannot write ") + path);
+}
+
+template <class Container>
+void    deserialize(const char* path, Container& c)
+{
+    vector<char>    buffer(serial_detail::file_buffer_size);
+    std::ifstream   in;
+    in.rdbuf()->pubsetbuf(buffer.data(), std::streamsize(buffer.size()));
+    in.open(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error(std::string("ft::deserialize: cannot open ") + path);
+    deserialize(static_cast<std::istream&>(in), c);
+}
+
+}
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef SET_HPP
+# define SET_HPP
+
+# include <memory>
+# include <functional>
+
+# include "BidirectionalIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "rb_tree.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+
+namespace ft{
+
+template< class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+class set
+{
+public:
+    typedef Key                                                                     key_type;
+    typedef Key                                                                     value_type;
+    typedef size_t                                                                  size_type;
+    typedef ptrdiff_t                                                               difference_type;
+    typedef Compare                                                                 key_compare;
+    typedef Compare                                                                 value_compare;
+    typedef Allocator                                                               allocator_type;
+    typedef value_type&                                                             reference;
+    typedef const value_type&                                                       const_reference;
+    typedef value_type*                                                             pointer;
+    typedef const value_type*                                                       const_pointer;
+    typedef typename rb_tree<Key, Key, identity<Key>, Compare, Allocator>::const_iterator  iterator;
+    typedef typename rb_tree<Key, Key, identity<Key>, Compare, Allocator>::const_iterator  const_iterator;
+    typedef ReverseBIterator<iterator>                                              reverse_iterator;
+    typedef ReverseBIterator<const_iterator>                                        const_reverse_iterator;
+private:
+    typedef rb_tree<Key, Key, identity<Key>, Compare, Allocator>                    tree_type;
+
+    tree_type           _tree;
+public:
+    set() : _tree()
+    {}
+
+    explicit set( const Compare& comp, const Allocator& alloc = Allocator()) : _tree(comp, alloc)
+    {}
+
+    template< class InputIterator >
+    set( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+    : _tree(comp, alloc)
+    { insert(first, last); }
+
+    set( const set& other ) : _tree(other._tree)
+    {}
+
+    set& operator= (const set& x)
+    {
+        if (this != &x)
+            _tree = x._tree;
+        return (*this);
+    }
+
+    ~set()
+    {}
+
+    void clear()
+    { _tree.clear(); }
+
+    pair<iterator, bool> insert( const value_type& value )
+    { return (_tree.insert_unique(value)); }
+
+    iterator insert( iterator hint, const value_type& value )
+    {
+        (void)hint;
+        return (insert(value).first);
+    }
+
+    template< class InputIterator >
+    void insert( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last )
+    {
+        for( ; first != last; ++first)
+            insert(*first);
+    }
+
+    // Replaces the contents with [first, last), which must already be in
+    // key order with no duplicates. The tree is built in linear time
+    // instead of one insert per element. Takes forward iterators only, as
+    // the range is counted before it is read; for a single-pass range,
+    // pass its length to assign_sorted(first, n).
+    template< class ForwardIterator >
+    void assign_sorted( ForwardIterator first, typename ft::enable_if< ft::is_forward_iterator< ForwardIterator >::value,ForwardIterator >::type last )
+    { _tree.assign_sorted(first, size_type(std::distance(first, last))); }
+
+    // The same for the n elements read from first, which may be single-pass.
+    template< class InputIterator >
+    void assign_sorted( InputIterator first, size_type n )
+    { _tree.assign_sorted(first, n); }
+
+    iterator find( const Key& key ) const
+    { return (_tree.find(key)); }
+
+    void erase( iterator pos )
+    { _tree.erase(pos); }
+
+    void erase( iterator first, iterator last )
+    { _tree.erase(first, last); }
+
+    size_type erase( const key_type& key )
+    { return (_tree.erase(key)); }
+
+    iterator lower_bound( const Key& key ) const
+    { return (_tree.lower_bound(key)); }
+
+    iterator upper_bound( const Key& key ) const
+    { return (_tree.upper_bound(key)); }
+
+    pair<iterator,iterator> equal_range( const Key& key ) const
+    { return _tree.equal_range(key); }
+
+    size_type   count(const key_type& key) const
+    { return (_tree.find(key) != _tree.end()); }
+
+    key_compare key_comp() const
+    { return _tree.key_comp(); }
+
+    value_compare   value_comp() const
+    { return _tree.key_comp(); }
+
+    allocator_type  get_allocator() const
+    { return (_tree.get_allocator()); }
+
+    bool        empty() const { return (_tree.empty()); }
+    size_type   size() const { return (_tree.size()); }
+    size_type   max_size() const { return _tree.max_size(); }
+
+    iterator                begin (void) const
+    { return (_tree.begin()); }
+    iterator                end (void) const
+    { return (_tree.end()); }
+    reverse_iterator        rbegin (void) const
+    { return (end()); }
+    reverse_iterator        rend (void) const
+    { return (begin()); }
+
+    // Boundaries of about `parts` contiguous ranges, begin() to end().
+    template <class OutputIterator>
+    OutputIterator  split( size_type parts, OutputIterator out ) const
+    { return (_tree.split(parts, out)); }
+
+    // Hot-path counters, shared with every tree of the same node type.
+    static container_stats& stats()
+    { return (tree_type::stats()); }
+
+    memory_report memory_usage() const
+    {
+        memory_report r = _tree.memory_usage();
+        r.header = sizeof(*this);
+        return (r);
+    }
+
+    tree_shape  tree_stats() const
+    { return (_tree.tree_stats()); }
+
+# ifndef NDEBUG
+    void        validate() const
+    { _tree.validate(); }
+# endif
+
+    void swap (set& other)
+    { _tree.swap(other._tree); }
+};
+
+template< class Key, class Compare, class Allocator >
+bool operator< (const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return ft::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator==(const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return v1.size() == v2.size() && ft::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator!=(const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return !operator==(v1, v2);
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator<=(const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return (!operator<(v2, v1));
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator> (const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return operator<(v2, v1);
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator>=(const set<Key, Compare, Allocator >& v1, const set<Key, Compare, Allocator > & v2)
+{
+    return (!operator<(v1, v2));
+}
+
+template< class Key, class Compare, class Allocator >
+void swap(set<Key, Compare, Allocator >& x, set<Key, Compare, Allocator > & y)
+{
+    x.swap(y);
+}
+
+template< class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+class multiset
+{
+public:
+    typedef Key                                                                     key_type;
+    typedef Key                                                                     value_type;
+    typedef size_t                                                                  size_type;
+    typedef ptrdiff_t                                                               difference_type;
+    typedef Compare                                                                 key_compare;
+    typedef Compare                                                                 value_compare;
+    typedef Allocator                                                               allocator_type;
+    typedef value_type&                                                             reference;
+    typedef const value_type&                                                       const_reference;
+    typedef value_type*                                                             pointer;
+    typedef const value_type*                                                       const_pointer;
+    typedef typename rb_tree<Key, Key, identity<Key>, Compare, Allocator>::const_iterator  iterator;
+    typedef typename rb_tree<Key, Key, identity<Key>, Compare, Allocator>::const_iterator  const_iterator;
+    typedef ReverseBIterator<iterator>                                              reverse_iterator;
+    typedef ReverseBIterator<const_iterator>                                        const_reverse_iterator;
+private:
+    typedef rb_tree<Key, Key, identity<Key>, Compare, Allocator>                    tree_type;
+
+    tree_type           _tree;
+public:
+    multiset() : _tree()
+    {}
+
+    explicit multiset( const Compare& comp, const Allocator& alloc = Allocator()) : _tree(comp, alloc)
+    {}
+
+    template< class InputIterator >
+    multiset( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+    : _tree(comp, alloc)
+    { insert(first, last); }
+
+    multiset( const multiset& other ) : _tree(other._tree)
+    {}
+
+    multiset& operator= (const multiset& x)
+    {
+        if (this != &x)
+            _tree = x._tree;
+        return (*this);
+    }
+
+    ~multiset()
+    {}
+
+    void clear()
+    { _tree.clear(); }
+
+    iterator insert( const value_type& value )
+    { return (_tree.insert_equal(value)); }
+
+    iterator insert( iterator hint, const value_type& value )
+    {
+        (void)hint;
+        return (insert(value));
+    }
+
+    template< class InputIterator >
+    void insert( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last )
+    {
+        for( ; first != last; ++first)
+            insert(*first);
+    }
+
+    // Replaces the contents with [first, last), which must already be in
+    // key order. The tree is built in linear time instead of one insert
+    // per element. Takes forward iterators only, as the range is counted
+    // before it is read; for a single-pass range, pass its length to
+    // assign_sorted(first, n).
+    template< class ForwardIterator >
+    void assign_sorted( ForwardIterator first, typename ft::enable_if< ft::is_forward_iterator< ForwardIterator >::value,ForwardIterator >::type last )
+    { _tree.assign_sorted(first, size_type(std::distance(first, last))); }
+
+    // The same for the n elements read from first, which may be single-pass.
+    template< class InputIterator >
+    void assign_sorted( InputIterator first, size_type n )
+    { _tree.assign_sorted(first, n); }
+
+    iterator find( const Key& key ) const
+    { return (_tree.find(key)); }
+
+    void erase( iterator pos )
+    { _tree.erase(pos); }
+
+    void erase( iterator first, iterator last )
+    { _tree.erase(first, last); }
+
+    size_type erase( const key_type& key )
+    { return (_tree.erase(key)); }
+
+    iterator lower_bound( const Key& key ) const
+    { return (_tree.lower_bound(key)); }
+
+    iterator upper_bound( const Key& key ) const
+    { return (_tree.upper_bound(key)); }
+
+    pair<iterator,iterator> equal_range( const Key& key ) const
+    { return _tree.equal_range(key); }
+
+    size_type   count(const key_type& key) const
+    { return (_tree.count(key)); }
+
+    key_compare key_comp() const
+    { return _tree.key_comp(); }
+
+    value_compare   value_comp() const
+    { return _tree.key_comp(); }
+
+    allocator_type  get_allocator() const
+    { return (_tree.get_allocator()); }
+
+    bool        empty() const { return (_tree.empty()); }
+    size_type   size() const { return (_tree.size()); }
+    size_type   max_size() const { return _tree.max_size(); }
+
+    iterator                begin (void) const
+    { return (_tree.begin()); }
+    iterator                end (void) const
+    { return (_tree.end()); }
+    reverse_iterator        rbegin (void) const
+    { return (end()); }
+    reverse_iterator        rend (void) const
+    { return (begin()); }
+
+    // Boundaries of about `parts` contiguous ranges, begin() to end().
+    template <class OutputIterator>
+    OutputIterator  split( size_type parts, OutputIterator out ) const
+    { return (_tree.split(parts, out)); }
+
+    // Hot-path counters, shared with every tree of the same node type.
+    static container_stats& stats()
+    { return (tree_type::stats()); }
+
+    memory_report memory_usage() const
+    {
+        memory_report r = _tree.memory_usage();
+        r.header = sizeof(*this);
+        return (r);
+    }
+
+    tree_shape  tree_stats() const
+    { return (_tree.tree_stats()); }
+
+# ifndef NDEBUG
+    void        validate() const
+    { _tree.validate(); }
+# endif
+
+    void swap (multiset& other)
+    { _tree.swap(other._tree); }
+};
+
+template< class Key, class Compare, class Allocator >
+bool operator< (const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return ft::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator==(const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return v1.size() == v2.size() && ft::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator!=(const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return !operator==(v1, v2);
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator<=(const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return (!operator<(v2, v1));
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator> (const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return operator<(v2, v1);
+}
+
+template< class Key, class Compare, class Allocator >
+bool operator>=(const multiset<Key, Compare, Allocator >& v1, const multiset<Key, Compare, Allocator > & v2)
+{
+    return (!operator<(v1, v2));
+}
+
+template< class Key, class Compare, class Allocator >
+void swap(multiset<Key, Compare, Allocator >& x, multiset<Key, Compare, Allocator > & y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
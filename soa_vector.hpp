@@ -0,0 +1,343 @@
+#ifndef SOA_VECTOR_HPP
+# define SOA_VECTOR_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+# include <type_traits>
+
+# include "SoaIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "vector.hpp"
+# include "memory.hpp"
+
+namespace ft {
+
+// A contiguous run of one column, for passes that only need that field.
+template <typename T>
+class column_span
+{
+    T*      _data;
+    size_t  _size;
+public:
+    typedef T           value_type;
+    typedef T*          iterator;
+    typedef size_t      size_type;
+
+    column_span(T* data = nullptr, size_t size = 0) : _data(data), _size(size)
+    {}
+
+    T*          data() const
+    { return (_data); }
+
+    size_type   size() const
+    { return (_size); }
+
+    bool        empty() const
+    { return (!_size); }
+
+    iterator    begin() const
+    { return (_data); }
+
+    iterator    end() const
+    { return (_data + _size); }
+
+    T&          operator[](size_type i) const
+    { return (_data[i]); }
+};
+
+// A sequence of records stored field by field: every field has its own
+// array, so a pass over one field reads nothing else. Only pair records
+// are supported for now; soa_vector<pair<A, B> > keeps the firsts in one
+// ft::vector and the seconds in another, and its iterators hand out
+// soa_reference proxies in place of pair&.
+template <class T, class Alloc = std::allocator<T> >
+class soa_vector;
+
+template <class A, class B, class Alloc>
+class soa_vector<pair<A, B>, Alloc>
+{
+public:
+    typedef pair<A, B>                                                  value_type;
+    typedef Alloc                                                       allocator_type;
+    typedef soa_reference<A, B>                                         reference;
+    typedef soa_reference<const A, const B>                             const_reference;
+    typedef SoaIterator<A, B, false>                                    iterator;
+    typedef SoaIterator<A, B, true>                                     const_iterator;
+    typedef ReverseRIterator<iterator>                                  reverse_iterator;
+    typedef ReverseRIterator<const_iterator>                            const_reverse_iterator;
+    typedef ptrdiff_t                                                   difference_type;
+    typedef size_t                                                      size_type;
+    typedef vector<A, typename Alloc::template rebind<A>::other>        first_column_type;
+    typedef vector<B, typename Alloc::template rebind<B>::other>        second_column_type;
+private:
+    // Records are read through references into the columns, and a
+    // vector<bool> column is packed and has none to give.
+    static_assert(!std::is_same<A, bool>::value && !std::is_same<B, bool>::value,
+                  "ft::soa_vector does not support bool fields; use char");
+
+    first_column_type   _first;
+    second_column_type  _second;
+
+    // Undoes a partial insert of n records at index in the first column
+    // when the second one failed.
+    void    rollback(size_type index, size_type n)
+    { _first.erase(_first.begin() + index, _first.begin() + index + n); }
+public:
+    explicit soa_vector(const allocator_type& alloc = allocator_type())
+    : _first(alloc), _second(alloc)
+    {}
+
+    soa_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+    : _first(n, val.first, alloc), _second(n, val.second, alloc)
+    {}
+
+    template <class InputIterator>
+    soa_vector(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last,
+               const allocator_type& alloc = allocator_type())
+    : _first(alloc), _second(alloc)
+    { insert(end(), first, last); }
+
+    soa_vector(const soa_vector& x) : _first(x._first), _second(x._second)
+    {}
+
+    ~soa_vector()
+    {}
+
+    soa_vector& operator=(const soa_vector& x)
+    {
+        if (this != &x)
+        {
+            _first = x._first;
+            _second = x._second;
+        }
+        return (*this);
+    }
+
+    iterator                begin()
+    { return (iterator(_first.data(), _second.data())); }
+    const_iterator          begin() const
+    { return (const_iterator(_first.data(), _second.data())); }
+    iterator                end()
+    { return (begin() + size()); }
+    const_iterator          end() const
+    { return (begin() + size()); }
+    reverse_iterator        rbegin()
+    { return (end()); }
+    const_reverse_iterator  rbegin() const
+    { return (end()); }
+    reverse_iterator        rend()
+    { return (begin()); }
+    const_reverse_iterator  rend() const
+    { return (begin()); }
+
+    size_type   size() const
+    { return (_first.size()); }
+
+    size_type   max_size() const
+    { return (std::min(_first.max_size(), _second.max_size())); }
+
+    size_type   capacity() const
+    { return (std::min(_first.capacity(), _second.capacity())); }
+
+    bool        empty() const
+    { return (_first.empty()); }
+
+    void        reserve(size_type n)
+    {
+        _first.reserve(n);
+        _second.reserve(n);
+    }
+
+    void        resize(size_type n, const value_type& val = value_type())
+    {
+        size_type   old = size();
+        _first.resize(n, val.first);
+        try {
+            _second.resize(n, val.second);
+        } catch (...) {
+            if (n > old)
+                _first.resize(old);
+            throw ;
+        }
+    }
+
+    reference       operator[](size_type n)
+    { return (reference(_first.data()[n], _second.data()[n])); }
+    const_reference operator[](size_type n) const
+    { return (const_reference(_first.data()[n], _second.data()[n])); }
+
+    reference       at(size_type n)
+    {
+        if (n >= size())
+            throw std::out_of_range("soa_vector");
+        return ((*this)[n]);
+    }
+
+    const_reference at(size_type n) const
+    {
+        if (n >= size())
+            throw std::out_of_range("soa_vector");
+        return ((*this)[n]);
+    }
+
+    reference       front()
+    { return ((*this)[0]); }
+    const_reference front() const
+    { return ((*this)[0]); }
+    reference       back()
+    { return ((*this)[size() - 1]); }
+    const_reference back() const
+    { return ((*this)[size() - 1]); }
+
+    // One column on its own; scans and SIMD filters over a single field
+    // go through these.
+    column_span<A>          first_column()
+    { return (column_span<A>(_first.data(), size())); }
+    column_span<const A>    first_column() const
+    { return (column_span<const A>(_first.data(), size())); }
+    column_span<B>          second_column()
+    { return (column_span<B>(_second.data(), size())); }
+    column_span<const B>    second_column() const
+    { return (column_span<const B>(_second.data(), size())); }
+
+    void        assign(size_type n, const value_type& val)
+    {
+        clear();
+        insert(end(), n, val);
+    }
+
+    template <class InputIterator>
+    void        assign(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void        push_back(const value_type& val)
+    {
+        _first.push_back(val.first);
+        try {
+            _second.push_back(val.second);
+        } catch (...) {
+            _first.pop_back();
+            throw ;
+        }
+    }
+
+    void        pop_back()
+    {
+        _first.pop_back();
+        _second.pop_back();
+    }
+
+    iterator    insert(iterator position, const value_type& val)
+    {
+        size_type   index = position - begin();
+        insert(position, 1, val);
+        return (begin() + index);
+    }
+
+    void        insert(iterator position, size_type n, const value_type& val)
+    {
+        size_type   index = position - begin();
+        value_type  copy(val);
+        _first.insert(_first.begin() + index, n, copy.first);
+        try {
+            _second.insert(_second.begin() + index, n, copy.second);
+        } catch (...) {
+            rollback(index, n);
+            throw ;
+        }
+    }
+
+    // Splits the records into one column each first, so the source is
+    // read once and may be single-pass.
+    template <class InputIterator>
+    void        insert(iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type first, InputIterator last)
+    {
+        size_type           index = position - begin();
+        first_column_type   firsts;
+        second_column_type  seconds;
+        for ( ; first != last; ++first)
+        {
+            value_type  v(*first);
+            firsts.push_back(v.first);
+            seconds.push_back(v.second);
+        }
+        _first.insert(_first.begin() + index, firsts.begin(), firsts.end());
+        try {
+            _second.insert(_second.begin() + index, seconds.begin(), seconds.end());
+        } catch (...) {
+            rollback(index, firsts.size());
+            throw ;
+        }
+    }
+
+    iterator    erase(iterator position)
+    { return (erase(position, position + 1)); }
+
+    iterator    erase(iterator first, iterator last)
+    {
+        size_type   index = first - begin();
+        size_type   n = last - first;
+        _first.erase(_first.begin() + index, _first.begin() + index + n);
+        _second.erase(_second.begin() + index, _second.begin() + index + n);
+        return (begin() + index);
+    }
+
+    void        swap(soa_vector& x)
+    {
+        _first.swap(x._first);
+        _second.swap(x._second);
+    }
+
+    void        clear()
+    {
+        _first.clear();
+        _second.clear();
+    }
+
+    allocator_type  get_allocator() const
+    { return (allocator_type()); }
+
+    // Both columns together; payload is what the fields occupy, so the
+    // padding a pair would carry never shows up as overhead.
+    memory_report   memory_usage() const
+    {
+        memory_report   a = _first.memory_usage();
+        memory_report   b = _second.memory_usage();
+        a.payload += b.payload;
+        a.requested += b.requested;
+        a.reserved += b.reserved;
+        a.header = sizeof(*this);
+        return (a);
+    }
+};
+
+template <class A, class B, class Alloc>
+bool    operator==(const soa_vector<pair<A, B>, Alloc>& x, const soa_vector<pair<A, B>, Alloc>& y)
+{
+    return (x.size() == y.size()
+            && ft::equal(x.first_column().begin(), x.first_column().end(), y.first_column().begin(), y.first_column().end())
+            && ft::equal(x.second_column().begin(), x.second_column().end(), y.second_column().begin(), y.second_column().end()));
+}
+
+template <class A, class B, class Alloc>
+bool    operator!=(const soa_vector<pair<A, B>, Alloc>& x, const soa_vector<pair<A, B>, Alloc>& y)
+{
+    return (!(x == y));
+}
+
+template <class T, class Alloc>
+void    swap(soa_vector<T, Alloc>& x, soa_vector<T, Alloc>& y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -0,0 +1,527 @@
+#ifndef SORT_HPP
+# define SORT_HPP
+
+# include <algorithm>
+# include <climits>
+# include <cstring>
+# include <functional>
+# include <iterator>
+# include <utility>
+
+# include "pair.hpp"
+# include "vector.hpp"
+
+namespace ft {
+
+// Maps a key to an unsigned integer whose natural order matches the key's
+// operator<, which is what lets sort(first, last) hand it to radix_sort.
+// Types without a specialization are always comparison sorted.
+template <typename T>
+struct radix_traits
+{
+    static const bool value = false;
+};
+
+template <typename T>
+struct radix_unsigned
+{
+    static const bool value = true;
+    typedef T   key_type;
+
+    static key_type key(T x)
+    { return (x); }
+};
+
+// Flipping the sign bit moves negative values below positive ones.
+template <typename T, typename U>
+struct radix_signed
+{
+    static const bool value = true;
+    typedef U   key_type;
+
+    static key_type key(T x)
+    { return (static_cast<U>(x) ^ (U(1) << (sizeof(U) * CHAR_BIT - 1))); }
+};
+
+// IEEE floats: positive values need their sign bit set, negative values
+// need every bit inverted so that larger magnitudes sort first.
+template <typename T, typename U>
+struct radix_float
+{
+    static const bool value = true;
+    typedef U   key_type;
+
+    static key_type key(T x)
+    {
+        U   bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        const U sign = U(1) << (sizeof(U) * CHAR_BIT - 1);
+        return (bits & sign ? ~bits : bits | sign);
+    }
+};
+
+template <> struct radix_traits<unsigned char> : radix_unsigned<unsigned char> {};
+template <> struct radix_traits<unsigned short> : radix_unsigned<unsigned short> {};
+template <> struct radix_traits<unsigned int> : radix_unsigned<unsigned int> {};
+template <> struct radix_traits<unsigned long> : radix_unsigned<unsigned long> {};
+template <> struct radix_traits<unsigned long long> : radix_unsigned<unsigned long long> {};
+template <> struct radix_traits<signed char> : radix_signed<signed char, unsigned char> {};
+template <> struct radix_traits<short> : radix_signed<short, unsigned short> {};
+template <> struct radix_traits<int> : radix_signed<int, unsigned int> {};
+template <> struct radix_traits<long> : radix_signed<long, unsigned long> {};
+template <> struct radix_traits<long long> : radix_signed<long long, unsigned long long> {};
+template <> struct radix_traits<float> : radix_float<float, unsigned int> {};
+template <> struct radix_traits<double> : radix_float<double, unsigned long long> {};
+
+namespace sort_detail {
+
+enum
+{
+    insertion_threshold = 24,   // below this, insertion sort wins
+    ninther_threshold   = 128,  // above this, the pivot is a median of medians
+    partial_limit       = 8,    // moves allowed before giving up on presorted input
+    radix_threshold     = 256,  // below this, histograms cost more than they save
+    merge_run           = 32    // stable_sort insertion-sorts runs of this length
+};
+
+template <class It, class Compare>
+void    insertion_sort(It first, It last, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    if (first == last)
+        return ;
+    for (It cur = first + 1; cur != last; ++cur)
+    {
+        if (!comp(*cur, *(cur - 1)))
+            continue ;
+        T   tmp(std::move(*cur));
+        It  hole = cur;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (hole != first && comp(tmp, *(hole - 1)));
+        *hole = std::move(tmp);
+    }
+}
+
+// Same, but relies on an element before first that is not greater than
+// anything in the range, which saves the bounds check.
+template <class It, class Compare>
+void    unguarded_insertion_sort(It first, It last, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    if (first == last)
+        return ;
+    for (It cur = first + 1; cur != last; ++cur)
+    {
+        if (!comp(*cur, *(cur - 1)))
+            continue ;
+        T   tmp(std::move(*cur));
+        It  hole = cur;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (comp(tmp, *(hole - 1)));
+        *hole = std::move(tmp);
+    }
+}
+
+// Insertion sort that gives up after partial_limit element moves. Returns
+// true if the range ended up sorted.
+template <class It, class Compare>
+bool    partial_insertion_sort(It first, It last, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    if (first == last)
+        return (true);
+    size_t  moved = 0;
+    for (It cur = first + 1; cur != last; ++cur)
+    {
+        if (!comp(*cur, *(cur - 1)))
+            continue ;
+        T   tmp(std::move(*cur));
+        It  hole = cur;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (hole != first && comp(tmp, *(hole - 1)));
+        *hole = std::move(tmp);
+        moved += cur - hole;
+        if (moved > partial_limit)
+            return (false);
+    }
+    return (true);
+}
+
+template <class It, class Compare>
+void    sort2(It a, It b, Compare comp)
+{
+    if (comp(*b, *a))
+        std::iter_swap(a, b);
+}
+
+// Leaves the median of *a, *b, *c in *b.
+template <class It, class Compare>
+void    sort3(It a, It b, It c, Compare comp)
+{
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+template <class It, class Compare>
+void    sift_down(It first, ptrdiff_t len, ptrdiff_t i, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    T   tmp(std::move(first[i]));
+    for (ptrdiff_t child = 2 * i + 1; child < len; child = 2 * i + 1)
+    {
+        if (child + 1 < len && comp(first[child], first[child + 1]))
+            ++child;
+        if (!comp(tmp, first[child]))
+            break ;
+        first[i] = std::move(first[child]);
+        i = child;
+    }
+    first[i] = std::move(tmp);
+}
+
+// Fallback once partitioning has gone wrong too often: O(n log n) whatever
+// the input.
+template <class It, class Compare>
+void    heap_sort(It first, It last, Compare comp)
+{
+    ptrdiff_t   len = last - first;
+    for (ptrdiff_t i = len / 2; i-- > 0; )
+        sift_down(first, len, i, comp);
+    while (len > 1)
+    {
+        --len;
+        std::iter_swap(first, first + len);
+        sift_down(first, len, 0, comp);
+    }
+}
+
+// Partitions around *first into [< pivot] pivot [>= pivot]. Returns the
+// pivot's final position and whether the range was already partitioned.
+template <class It, class Compare>
+ft::pair<It, bool> partition_right(It first, It last, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    T   pivot(std::move(*first));
+    It  lo = first;
+    It  hi = last;
+    while (comp(*++lo, pivot))
+        ;
+    if (lo - 1 == first)
+        while (lo < hi && !comp(*--hi, pivot))
+            ;
+    else
+        while (!comp(*--hi, pivot))
+            ;
+    bool    partitioned = lo >= hi;
+    while (lo < hi)
+    {
+        std::iter_swap(lo, hi);
+        while (comp(*++lo, pivot))
+            ;
+        while (!comp(*--hi, pivot))
+            ;
+    }
+    It  pos = lo - 1;
+    *first = std::move(*pos);
+    *pos = std::move(pivot);
+    return (ft::make_pair(pos, partitioned));
+}
+
+// Partitions around *first into [<= pivot] [> pivot]. Used when the pivot
+// equals the element before the range, so everything equal to it is put
+// in place at once; returns the end of the equal run.
+template <class It, class Compare>
+It      partition_left(It first, It last, Compare comp)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+
+    T   pivot(std::move(*first));
+    It  lo = first;
+    It  hi = last;
+    while (comp(pivot, *--hi))
+        ;
+    if (hi + 1 == last)
+        while (lo < hi && !comp(pivot, *++lo))
+            ;
+    else
+        while (!comp(pivot, *++lo))
+            ;
+    while (lo < hi)
+    {
+        std::iter_swap(lo, hi);
+        while (comp(pivot, *--hi))
+            ;
+        while (!comp(pivot, *++lo))
+            ;
+    }
+    *first = std::move(*hi);
+    *hi = std::move(pivot);
+    return (hi);
+}
+
+// Swaps a few elements away from their current spots to break up inputs
+// that keep producing unbalanced partitions.
+template <class It>
+void    break_patterns(It first, It last)
+{
+    ptrdiff_t   len = last - first;
+    if (len < insertion_threshold)
+        return ;
+    ptrdiff_t   quarter = len / 4;
+    std::iter_swap(first, first + quarter);
+    std::iter_swap(last - 1, last - quarter);
+    if (len > ninther_threshold)
+    {
+        std::iter_swap(first + 1, first + (quarter + 1));
+        std::iter_swap(first + 2, first + (quarter + 2));
+        std::iter_swap(last - 2, last - (quarter + 1));
+        std::iter_swap(last - 3, last - (quarter + 2));
+    }
+}
+
+template <class It, class Compare>
+void    pdqsort(It first, It last, Compare comp, int bad_allowed, bool leftmost)
+{
+    for (;;)
+    {
+        ptrdiff_t   len = last - first;
+        if (len < insertion_threshold)
+        {
+            if (leftmost)
+                insertion_sort(first, last, comp);
+            else
+                unguarded_insertion_sort(first, last, comp);
+            return ;
+        }
+
+        ptrdiff_t   half = len / 2;
+        if (len > ninther_threshold)
+        {
+            sort3(first, first + half, last - 1, comp);
+            sort3(first + 1, first + (half - 1), last - 2, comp);
+            sort3(first + 2, first + (half + 1), last - 3, comp);
+            sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            std::iter_swap(first, first + half);
+        }
+        else
+            sort3(first + half, first, last - 1, comp);
+
+        // Everything left of the range is <= it; if that bound equals the
+        // pivot, the pivot is the smallest value here and partition_left
+        // takes all its copies out in one pass.
+        if (!leftmost && !comp(*(first - 1), *first))
+        {
+            first = partition_left(first, last, comp) + 1;
+            continue ;
+        }
+
+        ft::pair<It, bool> part = partition_right(first, last, comp);
+        It          pivot = part.first;
+        ptrdiff_t   l_len = pivot - first;
+        ptrdiff_t   r_len = last - (pivot + 1);
+        bool        unbalanced = l_len < len / 8 || r_len < len / 8;
+
+        if (unbalanced)
+        {
+            if (--bad_allowed == 0)
+            {
+                heap_sort(first, last, comp);
+                return ;
+            }
+            break_patterns(first, pivot);
+            break_patterns(pivot + 1, last);
+        }
+        else if (part.second
+                 && partial_insertion_sort(first, pivot, comp)
+                 && partial_insertion_sort(pivot + 1, last, comp))
+            return ;
+
+        pdqsort(first, pivot, comp, bad_allowed, leftmost);
+        first = pivot + 1;
+        leftmost = false;
+    }
+}
+
+template <class It, class Buffer, class Compare>
+void    merge_sort(It first, It last, Buffer buf, Compare comp)
+{
+    ptrdiff_t   len = last - first;
+    if (len <= merge_run)
+    {
+        insertion_sort(first, last, comp);
+        return ;
+    }
+    It  mid = first + len / 2;
+    merge_sort(first, mid, buf, comp);
+    merge_sort(mid, last, buf, comp);
+    if (!comp(*mid, *(mid - 1)))
+        return ;
+
+    // Moves the left half out, then merges it with the right half back
+    // into place. Ties take the left element, which keeps the sort stable.
+    Buffer  buf_end = std::move(first, mid, buf);
+    It      out = first;
+    It      right = mid;
+    while (buf != buf_end && right != last)
+    {
+        if (comp(*right, *buf))
+            *out++ = std::move(*right++);
+        else
+            *out++ = std::move(*buf++);
+    }
+    std::move(buf, buf_end, out);
+}
+
+template <class It>
+void    radix_sort(It first, It last)
+{
+    typedef typename std::iterator_traits<It>::value_type   T;
+    typedef radix_traits<T>                                 traits;
+    typedef typename traits::key_type                       key_type;
+
+    enum { passes = sizeof(key_type), buckets = 256 };
+
+    size_t  len = last - first;
+    size_t  count[passes][buckets];
+    std::memset(count, 0, sizeof(count));
+    for (It it = first; it != last; ++it)
+    {
+        key_type    k = traits::key(*it);
+        for (size_t p = 0; p < passes; ++p)
+            ++count[p][(k >> (p * CHAR_BIT)) & (buckets - 1)];
+    }
+
+    ft::vector<T>   scratch(len, *first);
+    T*              src = &scratch[0];
+    bool            in_scratch = false;
+    for (size_t p = 0; p < passes; ++p)
+    {
+        // A digit shared by every key would move nothing.
+        size_t* c = count[p];
+        if (c[traits::key(*first) >> (p * CHAR_BIT) & (buckets - 1)] == len)
+            continue ;
+        size_t  offset[buckets];
+        size_t  sum = 0;
+        for (size_t b = 0; b < buckets; ++b)
+        {
+            offset[b] = sum;
+            sum += c[b];
+        }
+        if (in_scratch)
+            for (T* x = src, *end = src + len; x != end; ++x)
+                first[offset[(traits::key(*x) >> (p * CHAR_BIT)) & (buckets - 1)]++] = *x;
+        else
+            for (It x = first; x != last; ++x)
+                src[offset[(traits::key(*x) >> (p * CHAR_BIT)) & (buckets - 1)]++] = *x;
+        in_scratch = !in_scratch;
+    }
+    if (in_scratch)
+        std::copy(src, src + len, first);
+}
+
+// Allows log2(n) unbalanced partitions before switching to heap_sort.
+template <class It, class Compare>
+void    sort(It first, It last, Compare comp)
+{
+    ptrdiff_t   len = last - first;
+    int         bad_allowed = 0;
+    while (len >>= 1)
+        ++bad_allowed;
+    pdqsort(first, last, comp, bad_allowed, true);
+}
+
+template <bool Radix>
+struct default_sort
+{
+    template <class It>
+    static void run(It first, It last)
+    {
+        typedef typename std::iterator_traits<It>::value_type   T;
+
+        sort_detail::sort(first, last, std::less<T>());
+    }
+};
+
+template <>
+struct default_sort<true>
+{
+    template <class It>
+    static void run(It first, It last)
+    {
+        typedef typename std::iterator_traits<It>::value_type   T;
+
+        if (last - first >= radix_threshold)
+            sort_detail::radix_sort(first, last);
+        else
+            sort_detail::sort(first, last, std::less<T>());
+    }
+};
+
+}
+
+template <class RandomIt, class Compare>
+void    sort(RandomIt first, RandomIt last, Compare comp)
+{
+    sort_detail::sort(first, last, comp);
+}
+
+// Integral and floating-point values are radix sorted; everything else
+// goes through the comparison sort with operator<.
+template <class RandomIt>
+void    sort(RandomIt first, RandomIt last)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+    sort_detail::default_sort<radix_traits<T>::value>::run(first, last);
+}
+
+// Sorts the key types radix_traits knows, in a stable linear-time pass per
+// byte of the key.
+template <class RandomIt>
+void    radix_sort(RandomIt first, RandomIt last)
+{
+    if (last - first > 1)
+        sort_detail::radix_sort(first, last);
+}
+
+template <class RandomIt, class Compare>
+void    stable_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+    ptrdiff_t   len = last - first;
+    if (len <= sort_detail::merge_run)
+    {
+        sort_detail::insertion_sort(first, last, comp);
+        return ;
+    }
+    ft::vector<T>   scratch(len - len / 2, *first);
+    sort_detail::merge_sort(first, last, &scratch[0], comp);
+}
+
+template <class RandomIt>
+void    stable_sort(RandomIt first, RandomIt last)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+    ft::stable_sort(first, last, std::less<T>());
+}
+
+}
+
+#endif
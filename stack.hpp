@@ -2,6 +2,7 @@
 # define STACK_HPP
 
 # include "vector.hpp"
+# include "memory.hpp"
 
 namespace ft {
 template <typename T, typename Container = ft::vector<T> >
@@ -20,7 +21,7 @@ public:
     {}
 
     ~stack()
-    { c.~container_type(); }
+    {}
 
     reference top()
     { return c.back(); }
@@ -40,6 +41,14 @@ public:
     bool empty() const
     { return c.empty(); }
 
+    // The underlying container's report, with this stack as the header.
+    memory_report memory_usage() const
+    {
+        memory_report r = c.memory_usage();
+        r.header = sizeof(*this);
+        return (r);
+    }
+
     template< class _T, class _Container >
     friend bool operator==( const ft::stack<_T,_Container>& lhs, const ft::stack<_T,_Container>& rhs );
     
@@ -0,0 +1,394 @@
+#ifndef STATIC_VECTOR_HPP
+# define STATIC_VECTOR_HPP
+
+# include <algorithm>
+# include <cassert>
+# include <cstdlib>
+# include <new>
+# include <stdexcept>
+# include <type_traits>
+
+# include "RandomIterator.hpp"
+# include "ReverseIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "memory.hpp"
+
+namespace ft {
+
+// What a static_vector does when asked to hold more than N elements.
+// overflow() must not return: the element would go past the buffer.
+// throw_on_overflow throws std::length_error; assert_on_overflow, for code
+// built without exceptions, reports through assert in debug builds and
+// aborts in every build.
+struct throw_on_overflow
+{
+    static void overflow()
+    { throw std::length_error("ft::static_vector"); }
+};
+
+struct assert_on_overflow
+{
+    [[noreturn]] static void overflow()
+    {
+        assert(!"ft::static_vector: capacity exceeded");
+        std::abort();
+    }
+};
+
+// The element buffer and the count. For a trivially copyable T nothing is
+// user-declared, so the static_vector on top is trivially copyable too and
+// can be memcpy'd or placed in shared memory as is; otherwise copies and
+// destruction go element by element.
+template <class T, size_t N, bool Trivial = std::is_trivially_copyable<T>::value>
+class static_vector_storage
+{
+protected:
+    size_t                      _sz;
+    alignas(T) unsigned char    _buf[N ? N * sizeof(T) : 1];
+
+    static_vector_storage() : _sz(0)
+    {}
+
+    T*          elements()
+    { return (reinterpret_cast<T*>(_buf)); }
+
+    const T*    elements() const
+    { return (reinterpret_cast<const T*>(_buf)); }
+
+    void        destroy_from(size_t n)
+    { _sz = n; }
+};
+
+template <class T, size_t N>
+class static_vector_storage<T, N, false>
+{
+protected:
+    size_t                      _sz;
+    alignas(T) unsigned char    _buf[N ? N * sizeof(T) : 1];
+
+    static_vector_storage() : _sz(0)
+    {}
+
+    static_vector_storage(const static_vector_storage& x) : _sz(0)
+    {
+        try {
+            for ( ; _sz < x._sz; ++_sz)
+                ::new (static_cast<void*>(elements() + _sz)) T(x.elements()[_sz]);
+        } catch (...) {
+            destroy_from(0);
+            throw ;
+        }
+    }
+
+    ~static_vector_storage()
+    { destroy_from(0); }
+
+    static_vector_storage&  operator=(const static_vector_storage& x)
+    {
+        if (this == &x)
+            return (*this);
+        size_t  common = std::min(_sz, x._sz);
+        std::copy(x.elements(), x.elements() + common, elements());
+        destroy_from(common);
+        for ( ; _sz < x._sz; ++_sz)
+            ::new (static_cast<void*>(elements() + _sz)) T(x.elements()[_sz]);
+        return (*this);
+    }
+
+    T*          elements()
+    { return (reinterpret_cast<T*>(_buf)); }
+
+    const T*    elements() const
+    { return (reinterpret_cast<const T*>(_buf)); }
+
+    // Destroys the elements from index n on.
+    void        destroy_from(size_t n)
+    {
+        while (_sz > n)
+            elements()[--_sz].~T();
+    }
+};
+
+// A vector of at most N elements kept inside the object: it never
+// allocates, and where the storage is trivially copyable so is the whole
+// vector. Growing past N calls Overflow::overflow().
+template <class T, size_t N, class Overflow = throw_on_overflow>
+class static_vector : private static_vector_storage<T, N>
+{
+    typedef static_vector_storage<T, N> storage;
+
+    using storage::_sz;
+    using storage::elements;
+    using storage::destroy_from;
+public:
+    typedef T                                           value_type;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef RandomIterator<value_type, false>           iterator;
+    typedef RandomIterator<value_type const, true>      const_iterator;
+    typedef ReverseRIterator<iterator>                  reverse_iterator;
+    typedef ReverseRIterator<const_iterator>            const_reverse_iterator;
+    typedef ptrdiff_t                                   difference_type;
+    typedef size_t                                      size_type;
+
+    static const size_type  static_capacity = N;
+private:
+    // Makes sure n more elements fit.
+    void        check(size_type n) const
+    {
+        if (n > N - _sz)
+            Overflow::overflow();
+    }
+
+    void        construct_back(const value_type& val)
+    {
+        ::new (static_cast<void*>(elements() + _sz)) T(val);
+        ++_sz;
+    }
+public:
+    static_vector()
+    {}
+
+    explicit static_vector(size_type n, const value_type& val = value_type())
+    { insert(end(), n, val); }
+
+    template <class InputIterator>
+    static_vector(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    { insert(end(), first, last); }
+
+    iterator                begin()
+    { return (elements()); }
+    const_iterator          begin() const
+    { return (elements()); }
+    iterator                end()
+    { return (elements() + _sz); }
+    const_iterator          end() const
+    { return (elements() + _sz); }
+    reverse_iterator        rbegin()
+    { return (end()); }
+    const_reverse_iterator  rbegin() const
+    { return (end()); }
+    reverse_iterator        rend()
+    { return (begin()); }
+    const_reverse_iterator  rend() const
+    { return (begin()); }
+
+    size_type   size() const
+    { return (_sz); }
+
+    size_type   max_size() const
+    { return (N); }
+
+    size_type   capacity() const
+    { return (N); }
+
+    bool        empty() const
+    { return (!_sz); }
+
+    bool        full() const
+    { return (_sz == N); }
+
+    // Nothing to allocate; only checks that n fits.
+    void        reserve(size_type n)
+    {
+        if (n > N)
+            Overflow::overflow();
+    }
+
+    void        resize(size_type n, value_type val = value_type())
+    {
+        if (n > _sz)
+            insert(end(), n - _sz, val);
+        else
+            destroy_from(n);
+    }
+
+    reference       operator[](size_type n)
+    { return (elements()[n]); }
+    const_reference operator[](size_type n) const
+    { return (elements()[n]); }
+
+    reference       at(size_type n)
+    {
+        if (n >= _sz)
+            throw std::out_of_range("static_vector");
+        return (elements()[n]);
+    }
+
+    const_reference at(size_type n) const
+    {
+        if (n >= _sz)
+            throw std::out_of_range("static_vector");
+        return (elements()[n]);
+    }
+
+    reference       front()
+    { return (elements()[0]); }
+    const_reference front() const
+    { return (elements()[0]); }
+    reference       back()
+    { return (elements()[_sz - 1]); }
+    const_reference back() const
+    { return (elements()[_sz - 1]); }
+
+    pointer         data()
+    { return (elements()); }
+    const_pointer   data() const
+    { return (elements()); }
+
+    void        assign(size_type n, const value_type& val)
+    {
+        value_type  copy(val);
+        clear();
+        insert(end(), n, copy);
+    }
+
+    template <class InputIterator>
+    void        assign(InputIterator first, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type last)
+    {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void        push_back(const value_type& val)
+    {
+        check(1);
+        construct_back(val);
+    }
+
+    void        pop_back()
+    { destroy_from(_sz - 1); }
+
+    iterator    insert(iterator position, const value_type& val)
+    {
+        size_type   index = position - begin();
+        insert(position, 1, val);
+        return (begin() + index);
+    }
+
+    // New elements are built at the end and rotated into place, so a
+    // throwing copy leaves the vector as it was.
+    void        insert(iterator position, size_type n, const value_type& val)
+    {
+        size_type   index = position - begin();
+        size_type   old = _sz;
+        check(n);
+        value_type  copy(val);
+        try {
+            while (_sz < old + n)
+                construct_back(copy);
+        } catch (...) {
+            destroy_from(old);
+            throw ;
+        }
+        std::rotate(begin() + index, begin() + old, end());
+    }
+
+    template <class InputIterator>
+    void        insert(iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value, InputIterator>::type first, InputIterator last)
+    {
+        size_type   index = position - begin();
+        size_type   old = _sz;
+        try {
+            for ( ; first != last; ++first)
+            {
+                check(1);
+                construct_back(*first);
+            }
+        } catch (...) {
+            destroy_from(old);
+            throw ;
+        }
+        std::rotate(begin() + index, begin() + old, end());
+    }
+
+    iterator    erase(iterator position)
+    { return (erase(position, position + 1)); }
+
+    iterator    erase(iterator first, iterator last)
+    {
+        size_type   index = first - begin();
+        std::copy(last, end(), first);
+        destroy_from(_sz - (last - first));
+        return (begin() + index);
+    }
+
+    // Swaps element by element; there is no buffer to hand over.
+    void        swap(static_vector& x)
+    {
+        static_vector&  longer = _sz < x._sz ? x : *this;
+        static_vector&  shorter = _sz < x._sz ? *this : x;
+        size_type       common = shorter._sz;
+        std::swap_ranges(begin(), begin() + common, x.begin());
+        shorter.insert(shorter.end(), longer.begin() + common, longer.end());
+        longer.destroy_from(common);
+    }
+
+    void        clear()
+    { destroy_from(0); }
+
+    // Everything lives in the object itself: no allocation, and the header
+    // includes the unused slots.
+    memory_report   memory_usage() const
+    {
+        memory_report   r;
+        r.elements = _sz;
+        r.payload = _sz * sizeof(T);
+        r.requested = 0;
+        r.reserved = 0;
+        r.header = sizeof(*this);
+        return (r);
+    }
+};
+
+template <class T, size_t N, class Overflow>
+const size_t    static_vector<T, N, Overflow>::static_capacity;
+
+template <class T, size_t N, class Overflow>
+bool    operator==(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (ft::equal(a.begin(), a.end(), b.begin(), b.end()));
+}
+
+template <class T, size_t N, class Overflow>
+bool    operator!=(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (!(a == b));
+}
+
+template <class T, size_t N, class Overflow>
+bool    operator<(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (ft::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+}
+
+template <class T, size_t N, class Overflow>
+bool    operator<=(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (!(b < a));
+}
+
+template <class T, size_t N, class Overflow>
+bool    operator>(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (b < a);
+}
+
+template <class T, size_t N, class Overflow>
+bool    operator>=(const static_vector<T, N, Overflow>& a, const static_vector<T, N, Overflow>& b)
+{
+    return (!(a < b));
+}
+
+template <class T, size_t N, class Overflow>
+void    swap(static_vector<T, N, Overflow>& x, static_vector<T, N, Overflow>& y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
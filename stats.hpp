@@ -0,0 +1,109 @@
+#ifndef STATS_HPP
+# define STATS_HPP
+
+# include <atomic>
+# include <cstddef>
+# include <cstdio>
+# include <cstdlib>
+# include <typeinfo>
+# if defined(__GNUG__)
+#  include <cxxabi.h>
+# endif
+
+// Hot-path counters, compiled in only with FT_STATS defined. Without it
+// FT_STATS_ADD expands to nothing and the containers do no extra work;
+// stats() still exists and reports zeros.
+# ifdef FT_STATS
+#  define FT_STATS_ADD(stats, field, n) \
+    ((stats).field.fetch_add(static_cast<size_t>(n), std::memory_order_relaxed))
+# else
+#  define FT_STATS_ADD(stats, field, n) ((void)0)
+# endif
+
+namespace ft {
+
+// Counters shared by every instance of one container type. Updates are
+// relaxed atomics so that parallel traversals can count too.
+struct container_stats
+{
+    std::atomic<size_t> allocations;    // element blocks or nodes allocated
+    std::atomic<size_t> deallocations;
+    std::atomic<size_t> reallocations;  // vector::reserve moving to a new block
+    std::atomic<size_t> copies;         // elements copied or shifted
+    std::atomic<size_t> comparisons;    // calls to the key comparator
+    std::atomic<size_t> rotations;
+    std::atomic<size_t> rebalances;     // fix-up steps after insert and erase
+    std::atomic<size_t> climbs;         // extra links node::next/prev walk past the first
+
+    container_stats() : allocations(0), deallocations(0), reallocations(0), copies(0),
+                        comparisons(0), rotations(0), rebalances(0), climbs(0)
+    {}
+
+    void    reset()
+    {
+        allocations = 0;
+        deallocations = 0;
+        reallocations = 0;
+        copies = 0;
+        comparisons = 0;
+        rotations = 0;
+        rebalances = 0;
+        climbs = 0;
+    }
+};
+
+// One registered set of counters; every type that has asked for its stats
+// is on a single list that dump_stats walks.
+struct stats_entry
+{
+    const char*         name;
+    container_stats     counters;
+    stats_entry*        next;
+
+    static std::atomic<stats_entry*>&   head()
+    {
+        static std::atomic<stats_entry*>    list(nullptr);
+        return (list);
+    }
+
+    explicit stats_entry(const char* type_name) : name(type_name), next(head().load())
+    {
+        while (!head().compare_exchange_weak(next, this))
+            ;
+    }
+};
+
+template <typename Type>
+struct stats_of
+{
+    static container_stats& get()
+    {
+        static stats_entry  entry(typeid(Type).name());
+        return (entry.counters);
+    }
+};
+
+// Prints every registered counter set, one line per type.
+inline void dump_stats(FILE* out = stderr)
+{
+    for (stats_entry* e = stats_entry::head().load(); e; e = e->next)
+    {
+        const container_stats&  s = e->counters;
+        char*   readable = nullptr;
+# if defined(__GNUG__)
+        int     status = 0;
+        readable = abi::__cxa_demangle(e->name, nullptr, nullptr, &status);
+# endif
+        std::fprintf(out, "%s: allocations=%zu deallocations=%zu reallocations=%zu copies=%zu"
+                     " comparisons=%zu rotations=%zu rebalances=%zu climbs=%zu\n",
+                     readable ? readable : e->name,
+                     s.allocations.load(), s.deallocations.load(), s.reallocations.load(),
+                     s.copies.load(), s.comparisons.load(), s.rotations.load(),
+                     s.rebalances.load(), s.climbs.load());
+        std::free(readable);
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+// Stress test for ft::concurrent_stack: several threads push, pop,
+// push_range and pop_all against a pool small enough to run dry, and every
+// value pushed must come out exactly once. Build with -fsanitize=thread to
+// have the sanitizer check the memory ordering as well.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "concurrent_stack.hpp"
+
+namespace {
+
+const unsigned  threads = 4;
+const unsigned  per_thread = 200000;
+const size_t    pool = 256;
+
+// xorshift, one per thread.
+struct rng
+{
+    uint64_t    x;
+
+    explicit rng(uint64_t seed) : x(seed * 0x9E3779B97F4A7C15ull + 1)
+    {}
+
+    unsigned    operator()(unsigned n)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return (unsigned(x % n));
+    }
+};
+
+void    worker(ft::concurrent_stack<uint64_t>& s, unsigned id, std::vector<uint64_t>& popped)
+{
+    rng         r(id);
+    uint64_t    next = uint64_t(id) * per_thread;
+    uint64_t    end = next + per_thread;
+    while (next < end)
+    {
+        switch (r(4))
+        {
+        case 0:
+            if (s.push(next))
+                ++next;
+            break ;
+        case 1:
+        {
+            uint64_t    batch[16];
+            size_t      n = std::min<uint64_t>(1 + r(16), end - next);
+            for (size_t i = 0; i < n; ++i)
+                batch[i] = next + i;
+            next += s.push_range(batch, batch + n);
+            break ;
+        }
+        case 2:
+        {
+            uint64_t    v;
+            if (s.pop(v))
+                popped.push_back(v);
+            break ;
+        }
+        default:
+            if (!r(8))
+                s.pop_all(std::back_inserter(popped));
+            break ;
+        }
+    }
+}
+
+int     stress()
+{
+    ft::concurrent_stack<uint64_t>      s(pool);
+    std::vector<std::vector<uint64_t> > popped(threads);
+    std::vector<std::thread>            pool_threads;
+    for (unsigned t = 0; t < threads; ++t)
+        pool_threads.push_back(std::thread(worker, std::ref(s), t, std::ref(popped[t])));
+    for (unsigned t = 0; t < threads; ++t)
+        pool_threads[t].join();
+
+    std::vector<uint64_t>   all;
+    s.pop_all(std::back_inserter(all));
+    for (unsigned t = 0; t < threads; ++t)
+        all.insert(all.end(), popped[t].begin(), popped[t].end());
+    std::sort(all.begin(), all.end());
+    if (all.size() != size_t(threads) * per_thread)
+    {
+        std::fprintf(stderr, "stress: %zu values out, %zu in\n", all.size(), size_t(threads) * per_thread);
+        return (1);
+    }
+    for (size_t i = 0; i < all.size(); ++i)
+        if (all[i] != i)
+        {
+            std::fprintf(stderr, "stress: value %zu lost or duplicated\n", i);
+            return (1);
+        }
+    return (0);
+}
+
+// Copying out of the stack throws once armed.
+struct fragile
+{
+    static bool armed;
+    int         v;
+
+    fragile(int x = 0) : v(x)
+    {}
+
+    fragile(const fragile& x) : v(x.v)
+    {}
+
+    fragile&    operator=(const fragile& x)
+    {
+        if (armed)
+            throw std::runtime_error("fragile");
+        v = x.v;
+        return (*this);
+    }
+};
+
+bool    fragile::armed = false;
+
+// A pop or pop_all whose copy throws must leave the elements on the stack.
+int     throwing_copy()
+{
+    ft::concurrent_stack<fragile>   s(8);
+    for (int i = 0; i < 4; ++i)
+        s.push(fragile(i));
+    fragile                 out;
+    std::vector<fragile>    all(4);
+    fragile::armed = true;
+    try {
+        s.pop(out);
+    } catch (std::runtime_error&) {
+    }
+    try {
+        s.pop_all(all.begin());
+    } catch (std::runtime_error&) {
+    }
+    fragile::armed = false;
+    int                     sum = 0;
+    size_t                  n = 0;
+    while (s.pop(out))
+    {
+        sum += out.v;
+        ++n;
+    }
+    if (n != 4 || sum != 0 + 1 + 2 + 3)
+    {
+        std::fprintf(stderr, "throwing_copy: %zu elements left, sum %d\n", n, sum);
+        return (1);
+    }
+    return (0);
+}
+
+}
+
+int     main()
+{
+    return (stress() || throwing_copy());
+}
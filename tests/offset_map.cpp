@@ -0,0 +1,78 @@
+// ft::offset_map iterators must survive swap and the remaps that growth
+// causes, and keep reading the arena they were taken from. A map opened
+// read_only must refuse every writable access instead of faulting.
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+#include "offset_map.hpp"
+
+namespace {
+
+typedef ft::offset_map<int, int>    int_map;
+
+int     check(bool ok, const char* what)
+{
+    if (!ok)
+        std::fprintf(stderr, "offset_map: %s\n", what);
+    return (!ok);
+}
+
+// Whether f(m) throws std::logic_error.
+template <class F>
+bool    refused(int_map& m, F f)
+{
+    try {
+        f(m);
+    } catch (std::logic_error&) {
+        return (true);
+    }
+    return (false);
+}
+
+int     read_only(const std::string& path)
+{
+    int     failed = 0;
+    int_map r(path.c_str(), int_map::read_only);
+    const int_map&  cr = r;
+    failed += check(cr.at(7) == 14 && cr.find(7)->second == 14, "read-only lookup");
+    failed += check(cr.begin()->first == 0, "read-only iteration");
+    failed += check(refused(r, [](int_map& m) { m.at(5) = 42; }), "read-only at() handed out a reference");
+    failed += check(refused(r, [](int_map& m) { m.find(5); }), "read-only find() handed out an iterator");
+    failed += check(refused(r, [](int_map& m) { m.begin(); }), "read-only begin() handed out an iterator");
+    failed += check(refused(r, [](int_map& m) { m.insert(ft::make_pair(-1, 0)); }), "read-only insert");
+    failed += check(cr.at(5) == 10, "read-only map changed");
+    return (failed);
+}
+
+}
+
+int     main()
+{
+    std::string a_path = "offset_map_test_a." + std::to_string(::getpid());
+    std::string b_path = "offset_map_test_b." + std::to_string(::getpid());
+    int         failed = 0;
+    {
+        int_map a(a_path.c_str());
+        int_map b(b_path.c_str());
+        for (int i = 0; i < 100; ++i)
+            a.insert(ft::make_pair(i, 2 * i));
+        for (int i = 0; i < 5; ++i)
+            b.insert(ft::make_pair(1000 + i, i));
+        int_map::iterator       it = a.find(7);
+        int_map::const_iterator jt = b.find(1002);
+        a.swap(b);
+        failed += check(it->first == 7 && it->second == 14, "iterator lost its element after swap");
+        failed += check(jt->first == 1002, "const_iterator lost its element after swap");
+        failed += check(b.find(7) == it && a.find(1002) == jt, "iterator not in the swapped map");
+        for (int i = 100; i < 100000; ++i)
+            b.insert(ft::make_pair(i, i));
+        failed += check(it->first == 7 && it->second == 14, "iterator lost its element after a remap");
+    }
+    failed += read_only(a_path);
+    ::unlink(a_path.c_str());
+    ::unlink(b_path.c_str());
+    return (failed);
+}
@@ -0,0 +1,211 @@
+#ifndef THREAD_POOL_HPP
+# define THREAD_POOL_HPP
+
+# include <atomic>
+# include <condition_variable>
+# include <exception>
+# include <functional>
+# include <mutex>
+# include <thread>
+
+# include "deque.hpp"
+
+namespace ft {
+
+// Work-stealing pool: every worker owns a queue, runs its own tasks newest
+// first and steals the oldest task of another worker when it runs dry.
+// Tasks submitted from a worker stay on that worker's queue; tasks from
+// outside are dealt round-robin. A thread waiting on a task_group helps by
+// running pending tasks instead of blocking.
+class thread_pool
+{
+public:
+    typedef std::function<void()>   task_type;
+    typedef size_t                  size_type;
+private:
+    struct worker_queue
+    {
+        std::mutex              lock;
+        ft::deque<task_type>    tasks;
+    };
+
+    struct worker_id
+    {
+        const thread_pool*  pool;
+        size_type           index;
+    };
+
+    worker_queue*               _queues;
+    std::thread*                _threads;
+    size_type                   _size;
+    std::atomic<size_type>      _pending;
+    std::atomic<size_type>      _next;
+    std::mutex                  _sleep_lock;
+    std::condition_variable     _wake;
+    bool                        _stop;
+
+    thread_pool(const thread_pool&);
+    thread_pool&    operator=(const thread_pool&);
+
+    static worker_id&   current(void)
+    {
+        static thread_local worker_id   id = { nullptr, 0 };
+        return (id);
+    }
+
+    bool    take(size_type self, task_type& task)
+    {
+        for (size_type i = 0; i < _size; ++i)
+        {
+            worker_queue&   q = _queues[(self + i) % _size];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.tasks.empty())
+                continue ;
+            if (i == 0)
+            {
+                task = q.tasks.back();
+                q.tasks.pop_back();
+            }
+            else
+            {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+            }
+            --_pending;
+            return (true);
+        }
+        return (false);
+    }
+
+    void    work(size_type index)
+    {
+        current().pool = this;
+        current().index = index;
+        task_type   task;
+        for (;;)
+        {
+            if (take(index, task))
+            {
+                task();
+                task = task_type();
+                continue ;
+            }
+            std::unique_lock<std::mutex>    guard(_sleep_lock);
+            _wake.wait(guard, [this] { return (_stop || _pending.load() > 0); });
+            if (_stop && !_pending.load())
+                return ;
+        }
+    }
+public:
+    explicit thread_pool(size_type threads = std::thread::hardware_concurrency())
+    : _queues(nullptr), _threads(nullptr), _size(threads ? threads : 1), _pending(0), _next(0), _stop(false)
+    {
+        _queues = new worker_queue[_size];
+        _threads = new std::thread[_size];
+        for (size_type i = 0; i < _size; ++i)
+            _threads[i] = std::thread(&thread_pool::work, this, i);
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(_sleep_lock);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (size_type i = 0; i < _size; ++i)
+            _threads[i].join();
+        delete[] _threads;
+        delete[] _queues;
+    }
+
+    // Shared pool sized to the machine, started on first use.
+    static thread_pool& instance(void)
+    {
+        static thread_pool  pool;
+        return (pool);
+    }
+
+    size_type   size() const
+    { return (_size); }
+
+    void    submit(const task_type& task)
+    {
+        size_type   index = current().pool == this ? current().index : _next++ % _size;
+        // Counted under the queue lock: take() needs that lock to pop the
+        // task, so it cannot decrement _pending before it went up.
+        {
+            std::lock_guard<std::mutex> guard(_queues[index].lock);
+            _queues[index].tasks.push_back(task);
+            ++_pending;
+        }
+        std::lock_guard<std::mutex> guard(_sleep_lock);
+        _wake.notify_one();
+    }
+
+    // Runs one pending task on the calling thread, if there is any.
+    bool    run_one()
+    {
+        task_type   task;
+        if (!take(current().pool == this ? current().index : 0, task))
+            return (false);
+        task();
+        return (true);
+    }
+};
+
+// Tasks started together and waited for together. The first exception a
+// task throws is rethrown from wait().
+class task_group
+{
+    thread_pool&            _pool;
+    std::atomic<size_t>     _count;
+    std::exception_ptr      _error;
+    std::mutex              _error_lock;
+
+    task_group(const task_group&);
+    task_group& operator=(const task_group&);
+public:
+    explicit task_group(thread_pool& pool = thread_pool::instance()) : _pool(pool), _count(0)
+    {}
+
+    ~task_group()
+    {
+        while (_count.load(std::memory_order_acquire))
+            if (!_pool.run_one())
+                std::this_thread::yield();
+    }
+
+    template <class F>
+    void    run(const F& f)
+    {
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _pool.submit([this, f] {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(_error_lock);
+                if (!_error)
+                    _error = std::current_exception();
+            }
+            _count.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void    wait()
+    {
+        while (_count.load(std::memory_order_acquire))
+            if (!_pool.run_one())
+                std::this_thread::yield();
+        if (_error)
+        {
+            std::exception_ptr  error = _error;
+            _error = std::exception_ptr();
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef UNORDERED_MAP_HPP
+# define UNORDERED_MAP_HPP
+
+# include <memory>
+# include <functional>
+# include <algorithm>
+# include <stdexcept>
+# include <stdint.h>
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+# include "HashIterator.hpp"
+# include "IteratorTraits.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+
+namespace ft {
+
+// Sixteen control bytes probed at once. Each match returns a bitmask with
+// bit i set when byte i qualifies; SSE2 does it in a couple of instructions.
+struct hash_group
+{
+    enum { width = 16 };
+
+# if defined(__SSE2__)
+    __m128i ctrl;
+
+    explicit hash_group(const signed char* p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))
+    {}
+
+    unsigned    match(signed char h2) const
+    { return (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))); }
+
+    unsigned    match_empty(void) const
+    { return (match(hash_ctrl_empty)); }
+
+    unsigned    match_free(void) const
+    { return (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl_end), ctrl))); }
+# else
+    const signed char*  ctrl;
+
+    explicit hash_group(const signed char* p) : ctrl(p)
+    {}
+
+    unsigned    match(signed char h2) const
+    {
+        unsigned    mask = 0;
+        for (int i = 0; i < width; ++i)
+            mask |= unsigned(ctrl[i] == h2) << i;
+        return (mask);
+    }
+
+    unsigned    match_empty(void) const
+    { return (match(hash_ctrl_empty)); }
+
+    unsigned    match_free(void) const
+    {
+        unsigned    mask = 0;
+        for (int i = 0; i < width; ++i)
+            mask |= unsigned(ctrl[i] < hash_ctrl_end) << i;
+        return (mask);
+    }
+# endif
+};
+
+// Heterogeneous lookup is enabled when both Hash and KeyEqual declare
+// is_transparent. K is only there to make the test depend on the call.
+template <typename Hash, typename KeyEqual, typename K>
+struct transparent_lookup
+{
+    template <typename U> static char   test(typename U::is_transparent*);
+    template <typename U> static long   test(...);
+
+    static const bool value = sizeof(test<Hash>(0)) == 1 && sizeof(test<KeyEqual>(0)) == 1;
+};
+
+// Open-addressed hash map in the Swiss-table layout: a flat array of slots
+// plus one control byte per slot. A key's hash picks the first group to
+// probe (h1) and the seven bits kept in the control byte (h2); groups are
+// then visited in triangular order until one of them has an empty byte.
+// Only slots whose control byte equals h2 are compared with the key.
+template< class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>, class Allocator = std::allocator<pair<const Key, T> > >
+class unordered_map
+{
+public:
+    typedef Key                                                     key_type;
+    typedef T                                                       mapped_type;
+    typedef pair<const Key, T>                                      value_type;
+    typedef size_t                                                  size_type;
+    typedef ptrdiff_t                                               difference_type;
+    typedef Hash                                                    hasher;
+    typedef KeyEqual                                                key_equal;
+    typedef Allocator                                               allocator_type;
+    typedef value_type&                                             reference;
+    typedef const value_type&                                       const_reference;
+    typedef value_type*                                             pointer;
+    typedef const value_type*                                       const_pointer;
+    typedef HashIterator<value_type, false>                         iterator;
+    typedef HashIterator<value_type, true>                          const_iterator;
+private:
+    typedef typename Allocator::template rebind<value_type>::other  slot_allocator;
+    typedef typename Allocator::template rebind<signed char>::other ctrl_allocator;
+
+    enum { group_width = hash_group::width };
+
+    signed char*    _ctrl;
+    value_type*     _slots;
+    size_type       _capacity;
+    size_type       _sz;
+    size_type       _growth_left;
+    float           _max_load;
+    hasher          _hash;
+    key_equal       _eq;
+    slot_allocator  _alloc;
+    ctrl_allocator  _ctrl_alloc;
+public:
+    explicit unordered_map( size_type bucket_count = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+    : _ctrl(nullptr), _slots(nullptr), _capacity(0), _sz(0), _growth_left(0), _max_load(0.875f)
+    , _hash(hash), _eq(equal), _alloc(alloc), _ctrl_alloc(alloc)
+    { reserve(bucket_count); }
+
+    template< class InputIterator >
+    unordered_map( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last,
+        size_type bucket_count = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+    : _ctrl(nullptr), _slots(nullptr), _capacity(0), _sz(0), _growth_left(0), _max_load(0.875f)
+    , _hash(hash), _eq(equal), _alloc(alloc), _ctrl_alloc(alloc)
+    {
+        reserve(bucket_count);
+        insert(first, last);
+    }
+
+    unordered_map( const unordered_map& other )
+    : _ctrl(nullptr), _slots(nullptr), _capacity(0), _sz(0), _growth_left(0), _max_load(other._max_load)
+    , _hash(other._hash), _eq(other._eq), _alloc(other._alloc), _ctrl_alloc(other._ctrl_alloc)
+    {
+        reserve(other.size());
+        insert(other.begin(), other.end());
+    }
+
+    unordered_map&  operator= (const unordered_map& x)
+    {
+        if (this != &x)
+        {
+            unordered_map   tmp(x);
+            swap(tmp);
+        }
+        return (*this);
+    }
+
+    ~unordered_map()
+    {
+        clear();
+        release(_ctrl, _slots, _capacity);
+    }
+
+    iterator        begin (void)
+    { return (_capacity ? iterator(_ctrl, _slots).skip() : end()); }
+    const_iterator  begin (void) const
+    { return (_capacity ? const_iterator(_ctrl, _slots).skip() : end()); }
+    iterator        end (void)
+    { return (iterator(_ctrl + _capacity, _slots + _capacity)); }
+    const_iterator  end (void) const
+    { return (const_iterator(_ctrl + _capacity, _slots + _capacity)); }
+
+    bool        empty() const { return (!_sz); }
+    size_type   size() const { return (_sz); }
+    size_type   max_size() const { return (_alloc.max_size()); }
+
+    void clear()
+    {
+        for (size_type i = 0; i < _capacity; ++i)
+            if (_ctrl[i] >= 0)
+                _alloc.destroy(_slots + i);
+        if (_capacity)
+            std::fill(_ctrl, _ctrl + _capacity, static_cast<signed char>(hash_ctrl_empty));
+        _sz = 0;
+        _growth_left = max_growth(_capacity);
+    }
+
+    pair<iterator, bool> insert( const value_type& value )
+    {
+        size_t      h = hash(value.first);
+        iterator    it = find(value.first, h);
+        if (it != end())
+            return (ft::make_pair(it, false));
+        return (ft::make_pair(insert_new(value, h), true));
+    }
+
+    template< class InputIterator >
+    void insert( InputIterator first, typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type last )
+    {
+        for ( ; first != last; ++first)
+            insert(*first);
+    }
+
+    mapped_type&    operator [] (const Key& key)
+    {
+        size_t      h = hash(key);
+        iterator    it = find(key, h);
+        if (it == end())
+            it = insert_new(value_type(key, mapped_type()), h);
+        return (it->second);
+    }
+
+    T&  at (const Key& key)
+    {
+        iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("unordered_map::at:  key not found");
+        return (it->second);
+    }
+
+    const T&    at (const Key& key) const
+    {
+        const_iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("unordered_map::at:  key not found");
+        return (it->second);
+    }
+
+    iterator erase( const_iterator pos )
+    {
+        size_type   i = pos._slot - _slots;
+        _alloc.destroy(_slots + i);
+        --_sz;
+        // A group that still has an empty byte never stopped a probe, so the
+        // slot can become empty again; otherwise it has to stay a tombstone.
+        if (hash_group(_ctrl + i / group_width * group_width).match_empty())
+        {
+            _ctrl[i] = hash_ctrl_empty;
+            ++_growth_left;
+        }
+        else
+            _ctrl[i] = hash_ctrl_deleted;
+        return (iterator(_ctrl + i, _slots + i).skip());
+    }
+
+    iterator erase( const_iterator first, const_iterator last )
+    {
+        while (first != last)
+            first = erase(first);
+        return (iterator(_ctrl + (last._ctrl - _ctrl), _slots + (last._slot - _slots)));
+    }
+
+    size_type erase( const key_type& key )
+    {
+        iterator it = find(key);
+        if (it == end())
+            return (0);
+        erase(it);
+        return (1);
+    }
+
+    iterator        find( const Key& key )
+    { return (find(key, hash(key))); }
+
+    const_iterator  find( const Key& key ) const
+    { return (const_cast<unordered_map*>(this)->find(key, hash(key))); }
+
+    template <class K>
+    typename enable_if<transparent_lookup<Hash, KeyEqual, K>::value, iterator>::type
+    find( const K& key )
+    { return (find(key, hash(key))); }
+
+    template <class K>
+    typename enable_if<transparent_lookup<Hash, KeyEqual, K>::value, const_iterator>::type
+    find( const K& key ) const
+    { return (const_cast<unordered_map*>(this)->find(key, hash(key))); }
+
+    size_type   count( const Key& key ) const
+    { return (find(key) != end()); }
+
+    template <class K>
+    typename enable_if<transparent_lookup<Hash, KeyEqual, K>::value, size_type>::type
+    count( const K& key ) const
+    { return (find(key) != end()); }
+
+    pair<iterator, iterator> equal_range( const Key& key )
+    {
+        iterator    first = find(key);
+        iterator    last = first;
+        if (last != end())
+            ++last;
+        return (ft::make_pair(first, last));
+    }
+
+    pair<const_iterator, const_iterator> equal_range( const Key& key ) const
+    {
+        const_iterator  first = find(key);
+        const_iterator  last = first;
+        if (last != end())
+            ++last;
+        return (ft::make_pair(first, last));
+    }
+
+    size_type   bucket_count() const
+    { return (_capacity); }
+
+    float       load_factor() const
+    { return (_capacity ? float(_sz) / _capacity : 0.f); }
+
+    float       max_load_factor() const
+    { return (_max_load); }
+
+    // At least one byte per probe sequence has to stay empty, so the
+    // factor is capped at 15/16.
+    void        max_load_factor(float ml)
+    {
+        if (!(ml > 0.f))
+            throw std::invalid_argument("unordered_map::max_load_factor");
+        _max_load = std::min(ml, 15.f / 16.f);
+        size_type   used = _sz + tombstones();
+        if (used > max_growth(_capacity))
+            rehash(0);
+        else
+            _growth_left = max_growth(_capacity) - used;
+    }
+
+    // Rebuilds the table with room for at least count slots and the
+    // current elements, dropping tombstones.
+    void        rehash(size_type count)
+    {
+        size_type   cap = group_width;
+        while (cap < count || max_growth(cap) < _sz)
+            cap *= 2;
+        resize(cap);
+    }
+
+    void        reserve(size_type count)
+    {
+        if (count <= max_growth(_capacity))
+            return ;
+        size_type   cap = group_width;
+        while (max_growth(cap) < count)
+            cap *= 2;
+        resize(cap);
+    }
+
+    hasher          hash_function() const
+    { return (_hash); }
+
+    key_equal       key_eq() const
+    { return (_eq); }
+
+    allocator_type  get_allocator() const
+    { return (allocator_type(_alloc)); }
+
+    void swap (unordered_map& other)
+    {
+        ft::swap(_ctrl, other._ctrl);
+        ft::swap(_slots, other._slots);
+        ft::swap(_capacity, other._capacity);
+        ft::swap(_sz, other._sz);
+        ft::swap(_growth_left, other._growth_left);
+        ft::swap(_max_load, other._max_load);
+        ft::swap(_hash, other._hash);
+        ft::swap(_eq, other._eq);
+        ft::swap(_alloc, other._alloc);
+        ft::swap(_ctrl_alloc, other._ctrl_alloc);
+    }
+private:
+    // Spreads the bits of weak hashes (std::hash<int> is the identity).
+    template <class K>
+    size_t  hash(const K& key) const
+    {
+        uint64_t    h = static_cast<uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return (static_cast<size_t>(h ^ (h >> 32)));
+    }
+
+    static signed char  h2(size_t h)
+    { return (static_cast<signed char>(h & 0x7f)); }
+
+    size_type   max_growth(size_type cap) const
+    { return (cap ? std::min<size_type>(cap - 1, size_type(cap * _max_load)) : 0); }
+
+    size_type   tombstones(void) const
+    {
+        size_type   n = 0;
+        for (size_type i = 0; i < _capacity; ++i)
+            n += (_ctrl[i] == hash_ctrl_deleted);
+        return (n);
+    }
+
+    template <class K>
+    iterator    find(const K& key, size_t h)
+    {
+        if (!_capacity)
+            return (end());
+        size_type   mask = _capacity / group_width - 1;
+        size_type   g = (h >> 7) & mask;
+        for (size_type step = 1; ; ++step)
+        {
+            size_type   base = g * group_width;
+            hash_group  group(_ctrl + base);
+            for (unsigned m = group.match(h2(h)); m; m &= m - 1)
+            {
+                size_type   i = base + __builtin_ctz(m);
+                if (_eq(_slots[i].first, key))
+                    return (iterator(_ctrl + i, _slots + i));
+            }
+            if (group.match_empty())
+                return (end());
+            g = (g + step) & mask;
+        }
+    }
+
+    size_type   find_free(size_t h) const
+    {
+        size_type   mask = _capacity / group_width - 1;
+        size_type   g = (h >> 7) & mask;
+        for (size_type step = 1; ; ++step)
+        {
+            unsigned    m = hash_group(_ctrl + g * group_width).match_free();
+            if (m)
+                return (g * group_width + __builtin_ctz(m));
+            g = (g + step) & mask;
+        }
+    }
+
+    iterator    insert_new(const value_type& value, size_t h)
+    {
+        if (!_growth_left)
+        {
+            // Mostly tombstones: rebuild in place instead of doubling.
+            if (_capacity && _sz * 2 <= max_growth(_capacity))
+                resize(_capacity);
+            else
+                resize(_capacity ? _capacity * 2 : size_type(group_width));
+        }
+        size_type   i = find_free(h);
+        _alloc.construct(_slots + i, value);
+        if (_ctrl[i] == hash_ctrl_empty)
+            --_growth_left;
+        _ctrl[i] = h2(h);
+        ++_sz;
+        return (iterator(_ctrl + i, _slots + i));
+    }
+
+    void    release(signed char* ctrl, value_type* slots, size_type cap)
+    {
+        if (!cap)
+            return ;
+        _ctrl_alloc.deallocate(ctrl, cap + 1);
+        _alloc.deallocate(slots, cap);
+    }
+
+    void    resize(size_type cap)
+    {
+        signed char*    old_ctrl = _ctrl;
+        value_type*     old_slots = _slots;
+        size_type       old_cap = _capacity;
+
+        _ctrl = _ctrl_alloc.allocate(cap + 1);
+        try {
+            _slots = _alloc.allocate(cap);
+        } catch (...) {
+            _ctrl_alloc.deallocate(_ctrl, cap + 1);
+            _ctrl = old_ctrl;
+            throw ;
+        }
+        std::fill(_ctrl, _ctrl + cap, static_cast<signed char>(hash_ctrl_empty));
+        _ctrl[cap] = hash_ctrl_end;
+        _capacity = cap;
+        _growth_left = max_growth(cap) - _sz;
+
+        size_type   i = 0;
+        try {
+            for ( ; i < old_cap; ++i)
+            {
+                if (old_ctrl[i] < 0)
+                    continue ;
+                size_t      h = hash(old_slots[i].first);
+                size_type   j = find_free(h);
+                _alloc.construct(_slots + j, old_slots[i]);
+                _ctrl[j] = h2(h);
+            }
+        } catch (...) {
+            for (size_type j = 0; j < cap; ++j)
+                if (_ctrl[j] >= 0)
+                    _alloc.destroy(_slots + j);
+            release(_ctrl, _slots, cap);
+            _ctrl = old_ctrl;
+            _slots = old_slots;
+            _capacity = old_cap;
+            _growth_left = max_growth(old_cap) - (_sz + tombstones());
+            throw ;
+        }
+        for (i = 0; i < old_cap; ++i)
+            if (old_ctrl[i] >= 0)
+                _alloc.destroy(old_slots + i);
+        release(old_ctrl, old_slots, old_cap);
+    }
+};
+
+template< class Key, class T, class Hash, class KeyEqual, class Allocator >
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Allocator>& v1, const unordered_map<Key, T, Hash, KeyEqual, Allocator>& v2)
+{
+    if (v1.size() != v2.size())
+        return (false);
+    typedef typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator   const_iterator;
+    for (const_iterator it = v1.begin(); it != v1.end(); ++it)
+    {
+        const_iterator  other = v2.find(it->first);
+        if (other == v2.end() || !(other->second == it->second))
+            return (false);
+    }
+    return (true);
+}
+
+template< class Key, class T, class Hash, class KeyEqual, class Allocator >
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Allocator>& v1, const unordered_map<Key, T, Hash, KeyEqual, Allocator>& v2)
+{
+    return !operator==(v1, v2);
+}
+
+template< class Key, class T, class Hash, class KeyEqual, class Allocator >
+void swap(unordered_map<Key, T, Hash, KeyEqual, Allocator>& x, unordered_map<Key, T, Hash, KeyEqual, Allocator>& y)
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef UTILS_HPP
 # define UTILS_HPP
 
+# include <iterator>
+
 namespace ft{
 
 
@@ -15,6 +17,42 @@ struct enable_if<true, T>
     typedef T   type;
 };
 
+// True for iterators whose category is at least input_iterator_tag. Used
+// to keep (first, last) overloads from catching (count, value) calls.
+template <typename Iter>
+struct is_input_iterator
+{
+private:
+    static char category(std::input_iterator_tag);
+    static long category(...);
+
+    template <typename It>
+    static typename enable_if<sizeof(category(typename std::iterator_traits<It>::iterator_category())) == 1, char>::type
+                test(int);
+    template <typename It>
+    static long test(...);
+public:
+    static const bool value = sizeof(test<Iter>(0)) == 1;
+};
+
+// True for iterators whose category is at least forward_iterator_tag, for
+// the overloads that read a range twice.
+template <typename Iter>
+struct is_forward_iterator
+{
+private:
+    static char category(std::forward_iterator_tag);
+    static long category(...);
+
+    template <typename It>
+    static typename enable_if<sizeof(category(typename std::iterator_traits<It>::iterator_category())) == 1, char>::type
+                test(int);
+    template <typename It>
+    static long test(...);
+public:
+    static const bool value = sizeof(test<Iter>(0)) == 1;
+};
+
 template <typename InputIter1, typename InputIter2>
 bool    equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2)
 {
@@ -35,6 +73,20 @@ bool    lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2
     return (first1 == last1) && (first2 != last2);
 }
 
+template <typename Pair>
+struct select_first
+{
+    const typename Pair::first_type&    operator()(const Pair& x) const
+    { return (x.first); }
+};
+
+template <typename T>
+struct identity
+{
+    const T&    operator()(const T& x) const
+    { return (x); }
+};
+
 template <typename T>
 void    swap(T& x, T& y)
 {
@@ -1,13 +1,18 @@
 #ifndef VECTOR_HPP
 # define VECTOR_HPP
 
+# include <limits>
 # include <memory>
 # include <algorithm>
+# include <stdexcept>
 
 # include "RandomIterator.hpp"
+# include "BitIterator.hpp"
 # include "ReverseIterator.hpp"
 # include "IteratorTraits.hpp"
 # include "utils.hpp"
+# include "stats.hpp"
+# include "memory.hpp"
 
 
 namespace ft {
@@ -48,9 +53,12 @@ private:
 	{
 		_ptr = _alloc.allocate(n);
 		_capacity = n;
+		FT_STATS_ADD(stats(), allocations, 1);
 	}
 	void	deallocate(void)
 	{
+		if (_ptr)
+			FT_STATS_ADD(stats(), deallocations, 1);
 		_alloc.deallocate(_ptr, _capacity);
 		_ptr = nullptr;
 		_capacity = 0;
@@ -67,7 +75,7 @@ public:
 	}
 
     template < class InputIterator >
-    vector (typename ft::enable_if< std::__is_input_iterator< InputIterator >::value,InputIterator >::type first, InputIterator last, const allocator_type& alloc = allocator_type())
+    vector (typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type first, InputIterator last, const allocator_type& alloc = allocator_type())
 	:_ptr(nullptr), _sz(0), _capacity(0), _alloc(alloc)
 	{
 		assign(first, last);
@@ -86,6 +94,7 @@ public:
 
 	vector& operator= (const vector& x)
 	{
+		FT_STATS_ADD(stats(), copies, x.size());
 		assign(x.begin(), x.end());
 		return (*this);
 	}
@@ -169,6 +178,12 @@ public:
 		pointer 	old_ptr = _ptr;
 		size_type	old_cap = _capacity;
 		allocate(new_capacity);
+		if (old_ptr)
+		{
+			FT_STATS_ADD(stats(), reallocations, 1);
+			FT_STATS_ADD(stats(), deallocations, 1);
+			FT_STATS_ADD(stats(), copies, _sz);
+		}
 		for (size_type i = 0; i < _sz; ++i)
 		{
 			construct(_ptr + i, old_ptr[i]);
@@ -182,6 +197,11 @@ public:
 		return (_ptr[n]);
 	}
 
+	const_reference operator [] (difference_type n) const
+	{
+		return (_ptr[n]);
+	}
+
 	reference at (size_type n)
 	{
 		if (n >= _sz)
@@ -216,6 +236,16 @@ public:
 		return (_ptr[_sz - 1]);
 	}
 
+	pointer data()
+	{
+		return (_ptr);
+	}
+
+	const_pointer data() const
+	{
+		return (_ptr);
+	}
+
 	void assign (size_type n, const value_type& val)
 	{
 		size_type e_index = _sz;
@@ -229,7 +259,7 @@ public:
 			*it = val;
 	}
     template < class InputIterator >
-  	void assign (InputIterator first, typename ft::enable_if<std::__is_input_iterator< InputIterator >::value, InputIterator >::type last)
+  	void assign (InputIterator first, typename ft::enable_if<ft::is_input_iterator< InputIterator >::value, InputIterator >::type last)
 	{
 		size_type n = std::distance(first, last);
 
@@ -269,12 +299,13 @@ public:
 			return ;
 		size_type index = position - begin();
 		if (_sz + n > _capacity)
-			reserve(_sz + n);
+			reserve(std::max(_sz + n, 2 * _capacity));
 		if (index == _sz)
 			for (size_type i = 0; i < n; ++i)
 				construct(_ptr + _sz, val);
 		else
 		{
+			FT_STATS_ADD(stats(), copies, _sz - index);
 			reverse_iterator cpy_end(end());
 			reverse_iterator cpy_stop(_ptr + index);
 			reverse_iterator start(_ptr + _sz + n);
@@ -286,19 +317,20 @@ public:
 		}
 	}
     template < class InputIterator >
-    void insert (iterator position, typename ft::enable_if<std::__is_input_iterator<InputIterator>::value,InputIterator>::type first, InputIterator last)
+    void insert (iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value,InputIterator>::type first, InputIterator last)
 	{
 		size_type n = std::distance(first, last);
 		if (!n)
 			return ;
 		size_type index = position - begin();
 		if (_sz + n > _capacity)
-			reserve(_sz + n);
+			reserve(std::max(_sz + n, 2 * _capacity));
 		if (index == _sz)
 			for (iterator it(end()); first != last; ++it, ++first)
 				construct(&*it, *first);
 		else
 		{
+			FT_STATS_ADD(stats(), copies, _sz - index);
 			reverse_iterator cpy_end(end());
 			reverse_iterator cpy_stop(_ptr + index);
 			reverse_iterator start(_ptr + _sz + n);
@@ -314,6 +346,7 @@ public:
 	{
 		iterator				stop(--end());
 		iterator 	it(position);
+		FT_STATS_ADD(stats(), copies, stop - it);
 		for ( ; it != stop; it++)
 			*it = *(it + 1);
 		destroy(&*it);
@@ -326,7 +359,7 @@ public:
 		iterator 	ret(first);
 		iterator 	it(last);
 		iterator 	stop(end());
-
+		FT_STATS_ADD(stats(), copies, stop - it);
 
 		for ( ; it != stop; first++)
 			*first = *it++;
@@ -353,8 +386,463 @@ public:
 	{
 		return (allocator_type());
 	}
+
+	// Slack capacity is the overhead; the allocator may round the block up.
+	memory_report	memory_usage(void) const
+	{
+		memory_report	r;
+		r.elements = _sz;
+		r.payload = _sz * sizeof(value_type);
+		r.requested = _capacity * sizeof(value_type);
+		r.reserved = _ptr ? allocation_size<allocator_type>::reserved(_ptr, r.requested) : 0;
+		r.header = sizeof(*this);
+		return (r);
+	}
+
+	// Counters for every vector of this type; zeros unless built with FT_STATS.
+	static container_stats&	stats(void)
+	{
+		return (stats_of<vector>::get());
+	}
+};
+
+// Packed vector<bool>: 64 flags to a word instead of one per byte. Element
+// access goes through bit_reference proxies, and the bulk operations below
+// work a word at a time with popcount and count-trailing-zeros. Bits past
+// size() are always zero, which those operations rely on.
+template <class Alloc>
+class vector<bool, Alloc>
+{
+public:
+	typedef bool												value_type;
+	typedef Alloc												allocator_type;
+	typedef bit_reference										reference;
+	typedef bool												const_reference;
+	typedef BitIterator<false>									iterator;
+	typedef BitIterator<true>									const_iterator;
+	typedef ReverseRIterator<iterator>							reverse_iterator;
+	typedef ReverseRIterator<const_iterator>					const_reverse_iterator;
+	typedef ptrdiff_t											difference_type;
+	typedef size_t												size_type;
+
+	// What find_first and find_next return when there is no set bit.
+	static const size_type	npos = size_type(-1);
+private:
+	typedef typename Alloc::template rebind<bit_word>::other	word_allocator;
+
+	bit_word*		_words;
+	size_type		_sz;
+	size_type		_capacity;		// in words
+	word_allocator	_alloc;
+
+	static size_type	words_for(size_type bits)
+	{
+		return ((bits + bit_word_bits - 1) / bit_word_bits);
+	}
+
+	bool	get(size_type i) const
+	{
+		return ((_words[i / bit_word_bits] >> (i % bit_word_bits)) & 1);
+	}
+
+	void	set(size_type i, bool x)
+	{
+		bit_word	mask = bit_word(1) << (i % bit_word_bits);
+		if (x)
+			_words[i / bit_word_bits] |= mask;
+		else
+			_words[i / bit_word_bits] &= ~mask;
+	}
+
+	// Sets bits [first, last) to x, whole words in the middle.
+	void	fill(size_type first, size_type last, bool x)
+	{
+		while (first < last && first % bit_word_bits)
+			set(first++, x);
+		for ( ; first + bit_word_bits <= last; first += bit_word_bits)
+			_words[first / bit_word_bits] = x ? ~bit_word(0) : 0;
+		while (first < last)
+			set(first++, x);
+	}
+
+	// Shrinks to n bits and zeroes everything that was past it.
+	void	truncate(size_type n)
+	{
+		size_type	used = words_for(_sz);
+		_sz = n;
+		if (n % bit_word_bits)
+			_words[n / bit_word_bits] &= (bit_word(1) << (n % bit_word_bits)) - 1;
+		for (size_type w = words_for(n); w < used; ++w)
+			_words[w] = 0;
+	}
+
+	// Makes room for n bits at index; they are left as they were.
+	void	open_gap(size_type index, size_type n)
+	{
+		if (n > max_size() - _sz)
+			throw std::length_error("vector<bool>");
+		if (_sz + n > capacity())
+			reserve(std::max(_sz + n, 2 * capacity()));
+		size_type	old = _sz;
+		_sz += n;
+		for (size_type i = old; i-- > index; )
+			set(i + n, get(i));
+	}
+
+	static int	lowest_bit(bit_word w)
+	{
+		return (__builtin_ctzll(w));
+	}
+
+	static size_type	popcount(bit_word w)
+	{
+		return (size_type(__builtin_popcountll(w)));
+	}
+public:
+	explicit vector(const allocator_type& alloc = allocator_type())
+	: _words(nullptr), _sz(0), _capacity(0), _alloc(alloc)
+	{}
+
+	explicit vector(size_type n, const bool& val = false, const allocator_type& alloc = allocator_type())
+	: _words(nullptr), _sz(0), _capacity(0), _alloc(alloc)
+	{
+		assign(n, val);
+	}
+
+	template < class InputIterator >
+	vector(typename ft::enable_if< ft::is_input_iterator< InputIterator >::value,InputIterator >::type first, InputIterator last, const allocator_type& alloc = allocator_type())
+	: _words(nullptr), _sz(0), _capacity(0), _alloc(alloc)
+	{
+		assign(first, last);
+	}
+
+	vector(const vector& x) : _words(nullptr), _sz(0), _capacity(0), _alloc(x._alloc)
+	{
+		*this = x;
+	}
+
+	~vector()
+	{
+		if (_words)
+			_alloc.deallocate(_words, _capacity);
+	}
+
+	vector&	operator=(const vector& x)
+	{
+		if (this == &x)
+			return (*this);
+		clear();
+		reserve(x._sz);
+		for (size_type w = 0; w < words_for(x._sz); ++w)
+			_words[w] = x._words[w];
+		_sz = x._sz;
+		return (*this);
+	}
+
+	iterator				begin(void)
+	{ return (iterator(_words, 0)); }
+	const_iterator			begin(void) const
+	{ return (const_iterator(_words, 0)); }
+	iterator				end(void)
+	{ return (begin() + _sz); }
+	const_iterator			end(void) const
+	{ return (begin() + _sz); }
+	reverse_iterator		rbegin(void)
+	{ return (end()); }
+	const_reverse_iterator	rbegin(void) const
+	{ return (end()); }
+	reverse_iterator		rend(void)
+	{ return (begin()); }
+	const_reverse_iterator	rend(void) const
+	{ return (begin()); }
+
+	size_type	size() const
+	{ return (_sz); }
+
+	size_type	max_size() const
+	{
+		return (std::min(size_type(std::numeric_limits<difference_type>::max()),
+						 _alloc.max_size() * bit_word_bits));
+	}
+
+	size_type	capacity() const
+	{ return (_capacity * bit_word_bits); }
+
+	bool		empty(void) const
+	{ return (!_sz); }
+
+	void		reserve(size_type n)
+	{
+		size_type	words = words_for(n);
+		if (words <= _capacity)
+			return ;
+		bit_word*	p = _alloc.allocate(words);
+		FT_STATS_ADD(stats(), allocations, 1);
+		size_type	used = words_for(_sz);
+		for (size_type w = 0; w < used; ++w)
+			p[w] = _words[w];
+		for (size_type w = used; w < words; ++w)
+			p[w] = 0;
+		if (_words)
+		{
+			FT_STATS_ADD(stats(), reallocations, 1);
+			FT_STATS_ADD(stats(), deallocations, 1);
+			_alloc.deallocate(_words, _capacity);
+		}
+		_words = p;
+		_capacity = words;
+	}
+
+	void		resize(size_type n, bool val = false)
+	{
+		if (n < _sz)
+			truncate(n);
+		else
+			insert(end(), n - _sz, val);
+	}
+
+	reference		operator[](size_type n)
+	{ return (reference(_words + n / bit_word_bits, unsigned(n % bit_word_bits))); }
+	const_reference	operator[](size_type n) const
+	{ return (get(n)); }
+
+	reference		at(size_type n)
+	{
+		if (n >= _sz)
+			throw std::out_of_range("vector");
+		return ((*this)[n]);
+	}
+
+	const_reference	at(size_type n) const
+	{
+		if (n >= _sz)
+			throw std::out_of_range("vector");
+		return (get(n));
+	}
+
+	reference		front()
+	{ return ((*this)[0]); }
+	const_reference	front() const
+	{ return (get(0)); }
+	reference		back()
+	{ return ((*this)[_sz - 1]); }
+	const_reference	back() const
+	{ return (get(_sz - 1)); }
+
+	// The packed words, bit i of the vector at bit i % 64 of word i / 64.
+	// Writers must leave the bits past size() zero.
+	bit_word*		words()
+	{ return (_words); }
+	const bit_word*	words() const
+	{ return (_words); }
+
+	size_type		word_count() const
+	{ return (words_for(_sz)); }
+
+	void	assign(size_type n, const bool& val)
+	{
+		clear();
+		insert(end(), n, val);
+	}
+
+	template < class InputIterator >
+	void	assign(InputIterator first, typename ft::enable_if<ft::is_input_iterator< InputIterator >::value, InputIterator >::type last)
+	{
+		clear();
+		insert(end(), first, last);
+	}
+
+	void	push_back(const bool& val)
+	{
+		if (_sz == capacity())
+			reserve(std::max(_sz + 1, 2 * capacity()));
+		set(_sz++, val);
+	}
+
+	void	pop_back(void)
+	{ truncate(_sz - 1); }
+
+	iterator	insert(iterator position, const bool& val)
+	{
+		size_type	index = position - begin();
+		insert(position, 1, val);
+		return (begin() + index);
+	}
+
+	void	insert(iterator position, size_type n, const bool& val)
+	{
+		size_type	index = position - begin();
+		bool		x = val;
+		open_gap(index, n);
+		fill(index, index + n, x);
+	}
+
+	template < class InputIterator >
+	void	insert(iterator position, typename ft::enable_if<ft::is_input_iterator<InputIterator>::value,InputIterator>::type first, InputIterator last)
+	{
+		size_type	index = position - begin();
+		size_type	n = std::distance(first, last);
+		open_gap(index, n);
+		for ( ; first != last; ++first)
+			set(index++, *first);
+	}
+
+	iterator	erase(iterator position)
+	{ return (erase(position, position + 1)); }
+
+	iterator	erase(iterator first, iterator last)
+	{
+		size_type	index = first - begin();
+		size_type	n = last - first;
+		for (size_type i = index + n; i < _sz; ++i)
+			set(i - n, get(i));
+		truncate(_sz - n);
+		return (begin() + index);
+	}
+
+	void	swap(vector& x)
+	{
+		ft::swap(_words, x._words);
+		ft::swap(_sz, x._sz);
+		ft::swap(_capacity, x._capacity);
+		ft::swap(_alloc, x._alloc);
+	}
+
+	static void	swap(reference x, reference y)
+	{ ft::swap(x, y); }
+
+	void	clear(void)
+	{
+		if (_sz)
+			truncate(0);
+	}
+
+	allocator_type	get_allocator() const
+	{ return (allocator_type(_alloc)); }
+
+	// Number of set bits.
+	size_type	count() const
+	{
+		size_type	n = 0;
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			n += popcount(_words[w]);
+		return (n);
+	}
+
+	bool	any() const
+	{
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			if (_words[w])
+				return (true);
+		return (false);
+	}
+
+	bool	none() const
+	{ return (!any()); }
+
+	bool	all() const
+	{
+		size_type	full = _sz / bit_word_bits;
+		for (size_type w = 0; w < full; ++w)
+			if (~_words[w])
+				return (false);
+		if (_sz % bit_word_bits)
+			return (_words[full] == (bit_word(1) << (_sz % bit_word_bits)) - 1);
+		return (true);
+	}
+
+	// Index of the first set bit, or npos.
+	size_type	find_first() const
+	{
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			if (_words[w])
+				return (w * bit_word_bits + lowest_bit(_words[w]));
+		return (npos);
+	}
+
+	// Index of the first set bit after pos, or npos.
+	size_type	find_next(size_type pos) const
+	{
+		if (pos >= _sz || ++pos >= _sz)
+			return (npos);
+		size_type	w = pos / bit_word_bits;
+		bit_word	bits = _words[w] & (~bit_word(0) << (pos % bit_word_bits));
+		while (!bits)
+		{
+			if (++w >= words_for(_sz))
+				return (npos);
+			bits = _words[w];
+		}
+		return (w * bit_word_bits + lowest_bit(bits));
+	}
+
+	void	flip()
+	{
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			_words[w] = ~_words[w];
+		truncate(_sz);
+	}
+
+	// Bitwise operations with a vector of the same size; std::invalid_argument otherwise.
+	vector&	operator&=(const vector& x)
+	{
+		check_size(x);
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			_words[w] &= x._words[w];
+		return (*this);
+	}
+
+	vector&	operator|=(const vector& x)
+	{
+		check_size(x);
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			_words[w] |= x._words[w];
+		return (*this);
+	}
+
+	vector&	operator^=(const vector& x)
+	{
+		check_size(x);
+		for (size_type w = 0; w < words_for(_sz); ++w)
+			_words[w] ^= x._words[w];
+		return (*this);
+	}
+
+	// A word per 64 flags; the header is the vector object itself.
+	memory_report	memory_usage(void) const
+	{
+		memory_report	r;
+		r.elements = _sz;
+		r.payload = (_sz + 7) / 8;
+		r.requested = _capacity * sizeof(bit_word);
+		r.reserved = _words ? allocation_size<word_allocator>::reserved(_words, r.requested) : 0;
+		r.header = sizeof(*this);
+		return (r);
+	}
+
+	static container_stats&	stats(void)
+	{
+		return (stats_of<vector>::get());
+	}
+private:
+	void	check_size(const vector& x) const
+	{
+		if (x._sz != _sz)
+			throw std::invalid_argument("vector<bool>: size mismatch");
+	}
 };
 
+template < class Alloc >
+bool operator==(const vector<bool,Alloc>& v1, const vector<bool,Alloc>& v2)
+{
+	if (v1.size() != v2.size())
+		return (false);
+	for (size_t w = 0; w < v1.word_count(); ++w)
+		if (v1.words()[w] != v2.words()[w])
+			return (false);
+	return (true);
+}
+
 template < class T, class Alloc >
 bool operator< (const vector<T,Alloc>& v1, const vector<T,Alloc> & v2) 
 {